@@ -0,0 +1,15 @@
+#include <thread>
+
+#include "BenchmarkClock.h"
+
+double tsc_ticks_per_ns() {
+    static const double ticks_per_ns = []() {
+        if(!tsc_available()) return 0.0;
+        //measure the TSC over a 50ms sleep, long enough to keep the clock read overhead negligible
+        Timestamp start = timestamp();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        Timestamp end = timestamp();
+        return static_cast<double>(end.tsc-start.tsc)/(end.ns-start.ns);
+    }();
+    return ticks_per_ns;
+}
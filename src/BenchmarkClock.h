@@ -0,0 +1,54 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief A point in time read from both the steady clock and the time stamp counter
+ */
+struct Timestamp {
+    //steady clock in ns
+    int64_t ns;
+    //time stamp counter ticks, 0 if the platform has no TSC
+    uint64_t tsc;
+};
+
+/**
+ * @brief Reads the steady clock and the time stamp counter. The lfence keeps the TSC read
+ *        from being reordered with the code that is measured
+ */
+inline Timestamp timestamp() {
+    Timestamp t;
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_lfence();
+    t.tsc = __rdtsc();
+    _mm_lfence();
+#else
+    t.tsc = 0;
+#endif
+    t.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return t;
+}
+
+/**
+ * @brief Whether timestamp() reads a time stamp counter on this platform
+ */
+constexpr bool tsc_available() {
+#if defined(__x86_64__) || defined(__i386__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Frequency of the time stamp counter in ticks per ns, calibrated against the steady clock
+ *        on the first call. On CPUs with an invariant TSC the ticks are reference cycles at the
+ *        nominal frequency, not the (turbo) core cycles
+ *
+ * @return double ticks per ns, 0 if the platform has no TSC
+ */
+double tsc_ticks_per_ns();
@@ -0,0 +1,156 @@
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "BenchmarkEnvironment.h"
+
+namespace {
+
+//from linux/mempolicy.h, which is not installed everywhere
+constexpr int mpolBind{2};
+constexpr unsigned mpolMfStrict{1u << 0};
+constexpr unsigned mpolMfMove{1u << 1};
+
+std::runtime_error system_error(const std::string &what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+/**
+ * @brief First line of a sysfs file, empty if it cannot be read
+ */
+std::string read_line(const std::string &path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+/**
+ * @brief Node mask with only the node set, as mbind and set_mempolicy take it
+ */
+std::vector<unsigned long> node_mask(int node) {
+    constexpr int bitsPerWord = 8*sizeof(unsigned long);
+    if(node < 0) throw std::runtime_error("Invalid NUMA node " + std::to_string(node));
+    std::vector<unsigned long> mask(node/bitsPerWord+1, 0);
+    mask.at(node/bitsPerWord) = 1ul << (node%bitsPerWord);
+    return mask;
+}
+
+/**
+ * @brief The cpus the calling thread may run on
+ */
+std::vector<int> allowed_cpus() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    std::vector<int> cpus;
+    if(sched_getaffinity(0, sizeof(set), &set) != 0) return cpus;
+    for(int cpu=0; cpu<CPU_SETSIZE; ++cpu) {
+        if(CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+} // namespace
+
+std::vector<int> parse_cpu_list(const std::string &list) {
+    std::vector<int> cpus;
+    std::istringstream stream(list);
+    std::string range;
+    while(std::getline(stream, range, ',')) {
+        int first{0};
+        int last{0};
+        char dash{0};
+        std::istringstream values(range);
+        if(!(values >> first) || first < 0) throw std::invalid_argument("Invalid cpu list: " + list);
+        last = first;
+        if(values >> dash && (dash != '-' || !(values >> last) || last < first)) {
+            throw std::invalid_argument("Invalid cpu list: " + list);
+        }
+        if(!values.eof()) throw std::invalid_argument("Invalid cpu list: " + list);
+        for(int cpu=first; cpu<=last; ++cpu) cpus.push_back(cpu);
+    }
+    if(cpus.empty()) throw std::invalid_argument("Empty cpu list");
+    return cpus;
+}
+
+void pin_current_thread(const std::vector<int> &cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for(int cpu : cpus) {
+        if(cpu < 0 || cpu >= CPU_SETSIZE) throw std::runtime_error("Invalid cpu " + std::to_string(cpu));
+        CPU_SET(cpu, &set);
+    }
+    if(sched_setaffinity(0, sizeof(set), &set) != 0) throw system_error("Cannot pin the thread");
+}
+
+int numa_node_count() {
+    int nodes{0};
+    while(std::ifstream("/sys/devices/system/node/node" + std::to_string(nodes) + "/cpulist")) ++nodes;
+    return nodes > 0 ? nodes : 1;
+}
+
+void bind_thread_memory(int node) {
+    const std::vector<unsigned long> mask = node_mask(node);
+    if(syscall(SYS_set_mempolicy, mpolBind, mask.data(), mask.size()*8*sizeof(unsigned long)+1) != 0) {
+        throw system_error("Cannot bind memory to NUMA node " + std::to_string(node));
+    }
+}
+
+void move_to_node(const void *data, size_t bytes, int node) {
+    if(bytes == 0) return;
+    const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(data) & ~(pageSize-1);
+    const uintptr_t end = reinterpret_cast<uintptr_t>(data)+bytes;
+    const std::vector<unsigned long> mask = node_mask(node);
+    if(syscall(SYS_mbind, begin, end-begin, mpolBind, mask.data(), mask.size()*8*sizeof(unsigned long)+1,
+               mpolMfStrict | mpolMfMove) != 0) {
+        throw system_error("Cannot move memory to NUMA node " + std::to_string(node));
+    }
+}
+
+void prefault(void *data, size_t bytes) {
+    if(bytes == 0) return;
+    const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(data);
+    const uintptr_t end = begin+bytes;
+    //one byte in every page the buffer overlaps, the first page may start before the buffer
+    for(uintptr_t page = begin & ~(pageSize-1); page < end; page += pageSize) {
+        volatile char *byte = reinterpret_cast<volatile char *>(page < begin ? begin : page);
+        *byte = *byte;
+    }
+}
+
+std::vector<std::string> measurement_noise_warnings(const std::vector<int> &cpus) {
+    std::vector<std::string> warnings;
+    const std::vector<int> checked = cpus.empty() ? allowed_cpus() : cpus;
+    if(cpus.empty() && static_cast<int>(checked.size()) > 1) {
+        warnings.push_back("The benchmark is not pinned, the scheduler may migrate it between "
+                           + std::to_string(checked.size()) + " cpus");
+    }
+
+    //cpus per governor that is not performance
+    std::map<std::string, int> governors;
+    for(int cpu : checked) {
+        const std::string governor = read_line("/sys/devices/system/cpu/cpu" + std::to_string(cpu)
+                                               + "/cpufreq/scaling_governor");
+        if(!governor.empty() && governor != "performance") ++governors[governor];
+    }
+    for(const auto &governor : governors) {
+        warnings.push_back(std::to_string(governor.second) + " of the cpus use the " + governor.first
+                           + " governor, the clock follows the load instead of staying at its maximum");
+    }
+
+    //intel_pstate reports whether turbo is disabled, acpi-cpufreq and amd-pstate whether boost is enabled
+    if(read_line("/sys/devices/system/cpu/intel_pstate/no_turbo") == "0"
+       || read_line("/sys/devices/system/cpu/cpufreq/boost") == "1") {
+        warnings.push_back("Turbo boost is enabled, the clock depends on temperature and the load of other cores");
+    }
+    return warnings;
+}
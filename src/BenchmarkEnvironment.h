@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Parses a list of cpus as in /sys/devices/system/cpu/online, e.g. "0-3,8,10-11"
+ *
+ * @throw std::invalid_argument for malformed lists
+ */
+std::vector<int> parse_cpu_list(const std::string &list);
+
+/**
+ * @brief Restricts the calling thread to the given cpus with sched_setaffinity. Threads it starts
+ *        afterwards inherit the mask
+ *
+ * @throw std::runtime_error if the kernel rejects the mask, e.g. for offline cpus
+ */
+void pin_current_thread(const std::vector<int> &cpus);
+
+/**
+ * @brief Number of NUMA nodes the kernel reports, 1 without NUMA support
+ */
+int numa_node_count();
+
+/**
+ * @brief Lets all memory the calling thread allocates from now on come from one NUMA node
+ *        (set_mempolicy MPOL_BIND). Threads it starts afterwards inherit the policy
+ *
+ * @throw std::runtime_error if the node does not exist or the kernel has no NUMA support
+ */
+void bind_thread_memory(int node);
+
+/**
+ * @brief Migrates the pages of an existing buffer to a NUMA node and keeps them there (mbind
+ *        MPOL_BIND with MPOL_MF_MOVE). The range is widened to whole pages
+ *
+ * @throw std::runtime_error if the pages cannot be bound or moved
+ */
+void move_to_node(const void *data, size_t bytes, int node);
+
+/**
+ * @brief Touches every page of the buffer with a write that keeps its content, so no page fault
+ *        and no zero-page copy is left for the timed code
+ */
+void prefault(void *data, size_t bytes);
+
+/**
+ * @brief Describes everything that makes timings drift on the given cpus (all cpus the process may
+ *        run on if empty): governors other than performance, enabled turbo boost and a missing
+ *        affinity. Settings that cannot be read, e.g. in VMs without cpufreq, are left out
+ *
+ * @return std::vector<std::string> one line per issue, empty if none was found
+ */
+std::vector<std::string> measurement_noise_warnings(const std::vector<int> &cpus);
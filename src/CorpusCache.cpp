@@ -0,0 +1,196 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CorpusCache.h"
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "corpus files store the values as they are in memory");
+
+namespace {
+
+constexpr char corpusMagic[8] = {'P', 'Q', 'C', 'O', 'R', 'P', 'U', 'S'};
+constexpr uint32_t corpusVersion{1};
+constexpr uint64_t dataAlignment{4096};
+
+template<typename T>
+constexpr parquet::Type::type corpus_type();
+template<>
+constexpr parquet::Type::type corpus_type<int32_t>() { return parquet::Type::INT32; }
+template<>
+constexpr parquet::Type::type corpus_type<int64_t>() { return parquet::Type::INT64; }
+
+std::runtime_error system_error(const std::string &what, const std::string &path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+/**
+ * @brief Writes all bytes, retrying short writes
+ */
+void write_all(int fd, const void *data, size_t size, const std::string &path) {
+    const char *bytes = static_cast<const char *>(data);
+    while(size > 0) {
+        ssize_t written = ::write(fd, bytes, size);
+        if(written < 0) {
+            if(errno == EINTR) continue;
+            throw system_error("Cannot write", path);
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+/**
+ * @brief Describes the workload parameters that change the generated values
+ */
+std::string workload_source(const WorkloadSpec &spec) {
+    std::ostringstream source;
+    source << "workload=" << workload_name(spec.kind) << " delta=" << spec.delta << " seed=" << spec.seed
+           << " zipf_exponent=" << spec.zipf_exponent << " timestamp_start=" << spec.timestamp_start
+           << " jitter=" << spec.jitter << " gap_probability=" << spec.gap_probability
+           << " spike_interval=" << spec.spike_interval << " spike_magnitude=" << spec.spike_magnitude;
+    return source.str();
+}
+
+} // namespace
+
+template<typename T>
+void write_corpus(const std::string &path, const T *values, int64_t value_count, const std::string &source) {
+    CorpusHeader header{};
+    std::memcpy(header.magic, corpusMagic, sizeof(corpusMagic));
+    header.version = corpusVersion;
+    header.type = corpus_type<T>();
+    header.value_count = static_cast<uint64_t>(value_count);
+    header.source_size = static_cast<uint32_t>(source.size());
+    header.data_offset = (sizeof(CorpusHeader)+source.size()+dataAlignment-1)/dataAlignment*dataAlignment;
+
+    const std::string temporary = path + ".tmp";
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0) throw system_error("Cannot create", temporary);
+    try {
+        std::vector<char> prefix(header.data_offset, 0);
+        std::memcpy(prefix.data(), &header, sizeof(header));
+        std::memcpy(prefix.data()+sizeof(header), source.data(), source.size());
+        write_all(fd, prefix.data(), prefix.size(), temporary);
+        write_all(fd, values, static_cast<size_t>(value_count)*sizeof(T), temporary);
+    } catch (...) {
+        ::close(fd);
+        ::unlink(temporary.c_str());
+        throw;
+    }
+    if(::close(fd) != 0 || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        ::unlink(temporary.c_str());
+        throw system_error("Cannot write", path);
+    }
+}
+
+template void write_corpus<int32_t>(const std::string &, const int32_t *, int64_t, const std::string &);
+template void write_corpus<int64_t>(const std::string &, const int64_t *, int64_t, const std::string &);
+
+MappedCorpus::MappedCorpus(const std::string &path) : mapping(nullptr), mapping_size(0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) throw system_error("Cannot open", path);
+    struct stat status{};
+    if(::fstat(fd, &status) != 0) {
+        ::close(fd);
+        throw system_error("Cannot stat", path);
+    }
+    if(static_cast<size_t>(status.st_size) < sizeof(CorpusHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not a corpus file: " + path);
+    }
+    mapping_size = static_cast<size_t>(status.st_size);
+    //MAP_POPULATE reads the whole file now instead of faulting page by page during the roundtrips
+    mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_SHARED | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if(mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw system_error("Cannot map", path);
+    }
+    const CorpusHeader &h = header();
+    std::string problem;
+    if(std::memcmp(h.magic, corpusMagic, sizeof(corpusMagic)) != 0) problem = "not a corpus file";
+    else if(h.version != corpusVersion) problem = "unsupported version " + std::to_string(h.version);
+    else if(h.type != parquet::Type::INT32 && h.type != parquet::Type::INT64) problem = "unsupported value type";
+    else if(h.data_offset < sizeof(CorpusHeader)+h.source_size || h.data_offset % dataAlignment != 0) {
+        problem = "invalid data offset";
+    } else {
+        const uint64_t valueSize = h.type == parquet::Type::INT32 ? sizeof(int32_t) : sizeof(int64_t);
+        if(h.data_offset+h.value_count*valueSize > mapping_size) problem = "file is truncated";
+    }
+    if(!problem.empty()) {
+        ::munmap(mapping, mapping_size);
+        mapping = nullptr;
+        throw std::runtime_error("Invalid corpus " + path + ": " + problem);
+    }
+}
+
+MappedCorpus::~MappedCorpus() {
+    if(mapping != nullptr) ::munmap(mapping, mapping_size);
+}
+
+MappedCorpus::MappedCorpus(MappedCorpus &&other) noexcept
+    : mapping(std::exchange(other.mapping, nullptr)), mapping_size(std::exchange(other.mapping_size, 0)) {}
+
+MappedCorpus &MappedCorpus::operator=(MappedCorpus &&other) noexcept {
+    if(this != &other) {
+        if(mapping != nullptr) ::munmap(mapping, mapping_size);
+        mapping = std::exchange(other.mapping, nullptr);
+        mapping_size = std::exchange(other.mapping_size, 0);
+    }
+    return *this;
+}
+
+std::string MappedCorpus::source() const {
+    return std::string(static_cast<const char *>(mapping)+sizeof(CorpusHeader), header().source_size);
+}
+
+template<typename T>
+const T *MappedCorpus::values() const {
+    if(type() != corpus_type<T>()) {
+        throw std::invalid_argument("Corpus holds " + parquet::TypeToString(type()) + " values, not "
+                                    + parquet::TypeToString(corpus_type<T>()));
+    }
+    return reinterpret_cast<const T *>(static_cast<const char *>(mapping)+header().data_offset);
+}
+
+template const int32_t *MappedCorpus::values<int32_t>() const;
+template const int64_t *MappedCorpus::values<int64_t>() const;
+
+bool corpus_up_to_date(const std::string &path, const std::string &reference) {
+    struct stat corpus{};
+    struct stat source{};
+    if(::stat(path.c_str(), &corpus) != 0 || ::stat(reference.c_str(), &source) != 0) return false;
+    return corpus.st_mtime >= source.st_mtime;
+}
+
+template<typename T>
+MappedCorpus cached_workload(const std::string &directory, const WorkloadSpec &spec, int64_t value_count) {
+    const std::string source = workload_source(spec);
+    std::ostringstream name;
+    name << directory << '/' << workload_name(spec.kind) << '_' << spec.delta << '_' << spec.seed << '_'
+         << parquet::TypeToString(corpus_type<T>()) << ".corpus";
+    const std::string path = name.str();
+    if(::access(path.c_str(), R_OK) == 0) {
+        try {
+            MappedCorpus corpus(path);
+            if(corpus.type() == corpus_type<T>() && corpus.source() == source && corpus.value_count() >= value_count) {
+                return corpus;
+            }
+        } catch (const std::runtime_error &) {
+            //unreadable or from an older format, generate it again
+        }
+    }
+    std::vector<T> values = generate_workload<T>(spec, value_count);
+    write_corpus(path, values.data(), value_count, source);
+    return MappedCorpus(path);
+}
+
+template MappedCorpus cached_workload<int32_t>(const std::string &, const WorkloadSpec &, int64_t);
+template MappedCorpus cached_workload<int64_t>(const std::string &, const WorkloadSpec &, int64_t);
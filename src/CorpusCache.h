@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "parquet/types.h"
+
+#include "WorkloadGenerator.h"
+
+/**
+ * @brief Fixed part of the header at the start of a corpus file. It is followed by source_size bytes
+ *        describing where the values came from and, at data_offset (a multiple of 4096, so the
+ *        mapped values are page aligned), by value_count raw little-endian values
+ */
+struct CorpusHeader {
+    char magic[8];
+    uint32_t version;
+    //parquet::Type::type of the values, INT32 or INT64
+    uint32_t type;
+    uint64_t value_count;
+    uint64_t data_offset;
+    uint32_t source_size;
+    uint32_t reserved;
+};
+
+/**
+ * @brief Writes the values to a corpus file. The file is written under a temporary name and renamed,
+ *        so readers never see a partial corpus
+ *
+ * @param path Path of the corpus file, replaced if it exists
+ * @param values The int32_t or int64_t values to store
+ * @param value_count The number of values
+ * @param source Description of the values, e.g. the Parquet file and column they were read from
+ * @throw std::runtime_error if the file cannot be written
+ */
+template<typename T>
+void write_corpus(const std::string &path, const T *values, int64_t value_count, const std::string &source);
+
+extern template void write_corpus<int32_t>(const std::string &, const int32_t *, int64_t, const std::string &);
+extern template void write_corpus<int64_t>(const std::string &, const int64_t *, int64_t, const std::string &);
+
+/**
+ * @brief Read-only memory mapping of a corpus file. The pages are populated when the file is opened,
+ *        so no page faults land in the timed roundtrips, and are shared with the page cache instead
+ *        of being copied into the process
+ */
+class MappedCorpus {
+public:
+    /**
+     * @brief Maps the corpus file
+     *
+     * @throw std::runtime_error if the file cannot be mapped or is not a valid corpus
+     */
+    explicit MappedCorpus(const std::string &path);
+    ~MappedCorpus();
+    MappedCorpus(MappedCorpus &&other) noexcept;
+    MappedCorpus &operator=(MappedCorpus &&other) noexcept;
+    MappedCorpus(const MappedCorpus &) = delete;
+    MappedCorpus &operator=(const MappedCorpus &) = delete;
+
+    parquet::Type::type type() const { return static_cast<parquet::Type::type>(header().type); }
+    int64_t value_count() const { return static_cast<int64_t>(header().value_count); }
+    std::string source() const;
+
+    /**
+     * @brief The mapped values, valid as long as the corpus is
+     *
+     * @throw std::invalid_argument if T does not match the stored type
+     */
+    template<typename T>
+    const T *values() const;
+
+private:
+    const CorpusHeader &header() const { return *static_cast<const CorpusHeader *>(mapping); }
+
+    void *mapping;
+    size_t mapping_size;
+};
+
+extern template const int32_t *MappedCorpus::values<int32_t>() const;
+extern template const int64_t *MappedCorpus::values<int64_t>() const;
+
+/**
+ * @brief Whether the file exists and was modified no earlier than the reference file, e.g. a corpus
+ *        extracted from a Parquet file that has not been replaced since
+ */
+bool corpus_up_to_date(const std::string &path, const std::string &reference);
+
+/**
+ * @brief Maps the cached corpus of the workload from directory, generating and writing it first if
+ *        it does not exist yet, was generated with other parameters or holds fewer than value_count
+ *        values. A cached corpus may hold more values, its first value_count values are the ones
+ *        generate_workload would return, as long as the generator is unchanged
+ *
+ * @param directory Existing directory the corpus files are kept in
+ * @param spec The workload and its parameters
+ * @param value_count The minimum number of values
+ * @return MappedCorpus the mapped corpus of at least value_count values
+ */
+template<typename T>
+MappedCorpus cached_workload(const std::string &directory, const WorkloadSpec &spec, int64_t value_count);
+
+extern template MappedCorpus cached_workload<int32_t>(const std::string &, const WorkloadSpec &, int64_t);
+extern template MappedCorpus cached_workload<int64_t>(const std::string &, const WorkloadSpec &, int64_t);
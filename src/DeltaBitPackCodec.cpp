@@ -0,0 +1,1018 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "DeltaBitPackCodec.h"
+
+#if defined(__x86_64__)
+#define AVX2_KERNEL __attribute__((target("avx2")))
+#define AVX512_KERNEL __attribute__((target("avx512f,avx512bw")))
+#endif
+
+namespace {
+
+template<typename T>
+using Unsigned = typename std::make_unsigned<T>::type;
+
+//values per miniblock, the kernels pack and unpack groups of 32 of them
+template<typename T>
+constexpr int miniblockSize{deltaBlockSize<T>/deltaMiniblocksPerBlock};
+static_assert(miniblockSize<int32_t> % 32 == 0 && miniblockSize<int64_t> % 32 == 0,
+              "miniblocks have to consist of groups of 32 values");
+
+//bytes past the 4*bit_width bytes of a group the unpack kernels may read
+constexpr int64_t unpackOverread{16};
+
+uint8_t *put_uleb128(uint8_t *out, uint64_t value) {
+    while(value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    return out;
+}
+
+uint8_t *put_zigzag(uint8_t *out, int64_t value) {
+    return put_uleb128(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+/**
+ * @brief Reads an unsigned LEB128 varint and advances pos past it
+ *
+ * @return bool false if the varint is truncated or longer than 64 bits
+ */
+bool get_uleb128(const uint8_t *&pos, const uint8_t *end, uint64_t &value) {
+    value = 0;
+    for(int shift=0; shift<64 && pos < end; shift+=7) {
+        const uint8_t byte = *pos++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>((value >> 1) ^ (0-(value & 1)));
+}
+
+int required_bits(uint64_t value) {
+    return value == 0 ? 0 : 64-__builtin_clzll(value);
+}
+
+constexpr uint64_t low_bits_mask(int bit_width) {
+    return bit_width >= 64 ? ~uint64_t{0} : (uint64_t{1} << bit_width)-1;
+}
+
+std::runtime_error corrupt_page(const std::string &what) {
+    return std::runtime_error("Corrupt DELTA_BINARY_PACKED page: " + what);
+}
+
+/**
+ * @brief The encoder steps that have a kernel per SimdLevel
+ */
+template<typename T>
+struct EncodeKernels {
+    //deltas[i] = values[i+1]-values[i], wrapping, for i in [0, count)
+    void (*deltas)(const T *values, int count, T *deltas);
+    T (*min)(const T *values, int count);
+    T (*max)(const T *values, int count);
+    //packs the 32 deltas minus min_delta LSB first with bit_width bits each into 4*bit_width bytes
+    void (*pack32)(const T *deltas, T min_delta, int bit_width, uint8_t *out);
+};
+
+/**
+ * @brief The decoder steps that have a kernel per SimdLevel
+ */
+template<typename T>
+struct DecodeKernels {
+    //unpacks 32 values of bit_width bits, reads up to unpackOverread bytes past the 4*bit_width bytes
+    void (*unpack32)(const uint8_t *in, int bit_width, Unsigned<T> *out);
+    //out[i] = last + the sum of min_delta+deltas[k] for k in [0, i], wrapping, returns out[count-1]
+    Unsigned<T> (*prefix_sum)(const Unsigned<T> *deltas, int count, Unsigned<T> min_delta, Unsigned<T> last, T *out);
+};
+
+//__________________________scalar__________________________
+
+template<typename T>
+void deltas_scalar(const T *values, int count, T *deltas) {
+    for(int i=0; i<count; ++i) {
+        deltas[i] = static_cast<T>(static_cast<Unsigned<T>>(values[i+1])-static_cast<Unsigned<T>>(values[i]));
+    }
+}
+
+template<typename T>
+T min_scalar(const T *values, int count) {
+    return *std::min_element(values, values+count);
+}
+
+template<typename T>
+T max_scalar(const T *values, int count) {
+    return *std::max_element(values, values+count);
+}
+
+template<typename T>
+void pack32_scalar(const T *deltas, T min_delta, int bit_width, uint8_t *out) {
+    if(bit_width == 0) return;
+    uint64_t buffer{0};
+    int bits{0};
+    for(int i=0; i<32; ++i) {
+        const uint64_t value = static_cast<Unsigned<T>>(static_cast<Unsigned<T>>(deltas[i])
+                                                        -static_cast<Unsigned<T>>(min_delta));
+        buffer |= value << bits;
+        bits += bit_width;
+        if(bits >= 64) {
+            std::memcpy(out, &buffer, sizeof(buffer));
+            out += sizeof(buffer);
+            bits -= 64;
+            //the bits of the value that did not fit
+            buffer = bits > 0 ? value >> (bit_width-bits) : 0;
+        }
+    }
+    //32 values always end on a byte boundary
+    std::memcpy(out, &buffer, bits/8);
+}
+
+template<typename T>
+void unpack32_scalar(const uint8_t *in, int bit_width, Unsigned<T> *out) {
+    const uint64_t mask = low_bits_mask(bit_width);
+    for(int i=0; i<32; ++i) {
+        const int bit = i*bit_width;
+        const uint8_t *byte = in+(bit >> 3);
+        const int shift = bit & 7;
+        uint64_t word;
+        std::memcpy(&word, byte, sizeof(word));
+        uint64_t value = word >> shift;
+        if(shift+bit_width > 64) value |= static_cast<uint64_t>(byte[8]) << (64-shift);
+        out[i] = static_cast<Unsigned<T>>(value & mask);
+    }
+}
+
+template<typename T>
+Unsigned<T> prefix_sum_scalar(const Unsigned<T> *deltas, int count, Unsigned<T> min_delta, Unsigned<T> last, T *out) {
+    for(int i=0; i<count; ++i) {
+        last += min_delta+deltas[i];
+        out[i] = static_cast<T>(last);
+    }
+    return last;
+}
+
+//__________________________per bit width__________________________
+
+/**
+ * @brief Unpacks value I of a group of 32 with the bit width known at compile time, so its byte
+ *        offset, its shift and whether it spans a 9th byte are constants
+ */
+template<typename T, int BitWidth, int I>
+inline void unpack_fixed_value(const uint8_t *in, Unsigned<T> *out) {
+    constexpr int bit = I*BitWidth;
+    constexpr int shift = bit & 7;
+    uint64_t word;
+    std::memcpy(&word, in+(bit >> 3), sizeof(word));
+    uint64_t value = word >> shift;
+    if constexpr (shift+BitWidth > 64) value |= static_cast<uint64_t>(in[(bit >> 3)+8]) << (64-shift);
+    out[I] = static_cast<Unsigned<T>>(value & low_bits_mask(BitWidth));
+}
+
+template<typename T, int BitWidth, int... I>
+void unpack32_fixed_values(const uint8_t *in, Unsigned<T> *out, std::integer_sequence<int, I...>) {
+    (unpack_fixed_value<T, BitWidth, I>(in, out), ...);
+}
+
+template<typename T, int BitWidth>
+void unpack32_fixed(const uint8_t *in, Unsigned<T> *out) {
+    if constexpr (BitWidth == 0) std::fill(out, out+32, 0);
+    else unpack32_fixed_values<T, BitWidth>(in, out, std::make_integer_sequence<int, 32>());
+}
+
+template<typename T>
+using FixedUnpack = void (*)(const uint8_t *, Unsigned<T> *);
+
+template<typename T, int... BitWidth>
+constexpr std::array<FixedUnpack<T>, sizeof...(BitWidth)> fixed_unpack_table(std::integer_sequence<int, BitWidth...>) {
+    return {{unpack32_fixed<T, BitWidth>...}};
+}
+
+//one kernel for every bit width a column of T can have, indexed by the width
+template<typename T>
+constexpr std::array<FixedUnpack<T>, 8*sizeof(T)+1> fixedUnpackKernels{
+    fixed_unpack_table<T>(std::make_integer_sequence<int, 8*sizeof(T)+1>())};
+
+template<typename T>
+void unpack32_specialized(const uint8_t *in, int bit_width, Unsigned<T> *out) {
+    fixedUnpackKernels<T>[bit_width](in, out);
+}
+
+#if defined(__x86_64__)
+
+//__________________________AVX2__________________________
+
+template<typename T>
+AVX2_KERNEL void deltas_avx2(const T *values, int count, T *deltas) {
+    constexpr int lanes = 32/sizeof(T);
+    int i{0};
+    for(; i+lanes<=count; i+=lanes) {
+        const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values+i+1));
+        const __m256i previous = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values+i));
+        const __m256i delta = sizeof(T) == 8 ? _mm256_sub_epi64(next, previous) : _mm256_sub_epi32(next, previous);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(deltas+i), delta);
+    }
+    deltas_scalar(values+i, count-i, deltas+i);
+}
+
+template<typename T, bool Max>
+AVX2_KERNEL T extreme_avx2(const T *values, int count) {
+    constexpr int lanes = 32/sizeof(T);
+    if(count < lanes) return Max ? max_scalar(values, count) : min_scalar(values, count);
+    __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+    int i{lanes};
+    for(; i+lanes<=count; i+=lanes) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values+i));
+        if constexpr (sizeof(T) == 8) {
+            //AVX2 has no 64 bit min and max
+            const __m256i vGreater = _mm256_cmpgt_epi64(v, acc);
+            acc = _mm256_blendv_epi8(acc, v, Max ? vGreater : _mm256_cmpgt_epi64(acc, v));
+        } else {
+            acc = Max ? _mm256_max_epi32(acc, v) : _mm256_min_epi32(acc, v);
+        }
+    }
+    alignas(32) std::array<T, lanes> accLanes;
+    _mm256_store_si256(reinterpret_cast<__m256i *>(accLanes.data()), acc);
+    T result = Max ? max_scalar(accLanes.data(), lanes) : min_scalar(accLanes.data(), lanes);
+    for(; i<count; ++i) result = Max ? std::max(result, values[i]) : std::min(result, values[i]);
+    return result;
+}
+
+/**
+ * @brief Loads 4 deltas minus min_delta zero extended to 64 bit lanes
+ */
+template<typename T>
+AVX2_KERNEL __m256i frame4_avx2(const T *deltas, T min_delta) {
+    if constexpr (sizeof(T) == 8) {
+        return _mm256_sub_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(deltas)),
+                                _mm256_set1_epi64x(min_delta));
+    } else {
+        return _mm256_cvtepu32_epi64(_mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(deltas)),
+                                                   _mm_set1_epi32(min_delta)));
+    }
+}
+
+/**
+ * @brief Shifts the values of a group of 8 into place in 64 bit lanes, each group takes bit_width
+ *        bytes. The lanes are merged into the output words by scalar ORs
+ */
+template<typename T>
+AVX2_KERNEL void pack32_avx2(const T *deltas, T min_delta, int bit_width, uint8_t *out) {
+    if(bit_width == 0) return;
+    const int64_t w = bit_width;
+    const __m256i shifts[2]{_mm256_set_epi64x(3*w & 63, 2*w & 63, w & 63, 0),
+                            _mm256_set_epi64x(7*w & 63, 6*w & 63, 5*w & 63, 4*w & 63)};
+    const __m256i sixtyFour = _mm256_set1_epi64x(64);
+    alignas(32) std::array<uint64_t, 8> low;
+    alignas(32) std::array<uint64_t, 8> high;
+    for(int g=0; g<4; ++g) {
+        for(int h=0; h<2; ++h) {
+            const __m256i v = frame4_avx2(deltas+8*g+4*h, min_delta);
+            //a shift by 64 yields 0, the high part of lanes starting on a word boundary
+            _mm256_store_si256(reinterpret_cast<__m256i *>(low.data()+4*h), _mm256_sllv_epi64(v, shifts[h]));
+            _mm256_store_si256(reinterpret_cast<__m256i *>(high.data()+4*h),
+                               _mm256_srlv_epi64(v, _mm256_sub_epi64(sixtyFour, shifts[h])));
+        }
+        std::array<uint64_t, 9> words{};
+        for(int j=0; j<8; ++j) {
+            const int word = (j*bit_width) >> 6;
+            words[word] |= low[j];
+            words[word+1] |= high[j];
+        }
+        std::memcpy(out+g*bit_width, words.data(), bit_width);
+    }
+}
+
+/**
+ * @brief Gathers the 8 bytes every value starts in and shifts it into place, widths above 56 bits
+ *        can span 9 bytes and are unpacked by the scalar kernel
+ */
+template<typename T>
+AVX2_KERNEL void unpack32_avx2(const uint8_t *in, int bit_width, Unsigned<T> *out) {
+    if(bit_width > 56) {
+        unpack32_scalar<T>(in, bit_width, out);
+        return;
+    }
+    const int64_t w = bit_width;
+    const __m256i mask = _mm256_set1_epi64x(static_cast<int64_t>(low_bits_mask(bit_width)));
+    const __m256i step = _mm256_set1_epi64x(4*w);
+    const __m256i sevens = _mm256_set1_epi64x(7);
+    __m256i offsets = _mm256_set_epi64x(3*w, 2*w, w, 0);
+    for(int q=0; q<8; ++q) {
+        const __m256i words = _mm256_i64gather_epi64(reinterpret_cast<const long long *>(in),
+                                                     _mm256_srli_epi64(offsets, 3), 1);
+        const __m256i v = _mm256_and_si256(_mm256_srlv_epi64(words, _mm256_and_si256(offsets, sevens)), mask);
+        if constexpr (sizeof(T) == 8) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out+4*q), v);
+        } else {
+            const __m256i packed = _mm256_permutevar8x32_epi32(v, _mm256_set_epi32(0, 0, 0, 0, 6, 4, 2, 0));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out+4*q), _mm256_castsi256_si128(packed));
+        }
+        offsets = _mm256_add_epi64(offsets, step);
+    }
+}
+
+/**
+ * @brief In-register prefix sum in log2(lanes) shift-and-add steps, the carry is the last lane
+ *        broadcast to all lanes
+ */
+template<typename T>
+AVX2_KERNEL Unsigned<T> prefix_sum_avx2(const Unsigned<T> *deltas, int count, Unsigned<T> min_delta,
+                                        Unsigned<T> last, T *out) {
+    constexpr int lanes = 32/sizeof(T);
+    const __m256i zero = _mm256_setzero_si256();
+    int i{0};
+    if constexpr (sizeof(T) == 8) {
+        const __m256i minDelta = _mm256_set1_epi64x(static_cast<int64_t>(min_delta));
+        __m256i carry = _mm256_set1_epi64x(static_cast<int64_t>(last));
+        for(; i+lanes<=count; i+=lanes) {
+            __m256i x = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(deltas+i)), minDelta);
+            x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+            x = _mm256_add_epi64(x, _mm256_permute2x128_si256(x, x, 0x08));
+            x = _mm256_add_epi64(x, carry);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out+i), x);
+            carry = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        last = static_cast<Unsigned<T>>(_mm256_extract_epi64(carry, 0));
+    } else {
+        const __m256i minDelta = _mm256_set1_epi32(static_cast<int32_t>(min_delta));
+        __m256i carry = _mm256_set1_epi32(static_cast<int32_t>(last));
+        for(; i+lanes<=count; i+=lanes) {
+            __m256i x = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(deltas+i)), minDelta);
+            //prefix sums within the 128 bit halves, then the low half's total is added to the high half
+            x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+            x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+            x = _mm256_add_epi32(x, _mm256_blend_epi32(zero, _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(3)), 0xf0));
+            x = _mm256_add_epi32(x, carry);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out+i), x);
+            carry = _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7));
+        }
+        last = static_cast<Unsigned<T>>(_mm256_extract_epi32(carry, 0));
+    }
+    return prefix_sum_scalar(deltas+i, count-i, min_delta, last, out+i);
+}
+
+//__________________________AVX-512__________________________
+
+template<typename T>
+AVX512_KERNEL void deltas_avx512(const T *values, int count, T *deltas) {
+    constexpr int lanes = 64/sizeof(T);
+    int i{0};
+    for(; i+lanes<=count; i+=lanes) {
+        const __m512i next = _mm512_loadu_si512(values+i+1);
+        const __m512i previous = _mm512_loadu_si512(values+i);
+        _mm512_storeu_si512(deltas+i, sizeof(T) == 8 ? _mm512_sub_epi64(next, previous) : _mm512_sub_epi32(next, previous));
+    }
+    deltas_scalar(values+i, count-i, deltas+i);
+}
+
+template<typename T, bool Max>
+AVX512_KERNEL T extreme_avx512(const T *values, int count) {
+    constexpr int lanes = 64/sizeof(T);
+    if(count < lanes) return Max ? max_scalar(values, count) : min_scalar(values, count);
+    __m512i acc = _mm512_loadu_si512(values);
+    int i{lanes};
+    for(; i+lanes<=count; i+=lanes) {
+        const __m512i v = _mm512_loadu_si512(values+i);
+        if constexpr (sizeof(T) == 8) acc = Max ? _mm512_max_epi64(acc, v) : _mm512_min_epi64(acc, v);
+        else acc = Max ? _mm512_max_epi32(acc, v) : _mm512_min_epi32(acc, v);
+    }
+    T result;
+    if constexpr (sizeof(T) == 8) result = Max ? _mm512_reduce_max_epi64(acc) : _mm512_reduce_min_epi64(acc);
+    else result = Max ? _mm512_reduce_max_epi32(acc) : _mm512_reduce_min_epi32(acc);
+    for(; i<count; ++i) result = Max ? std::max(result, values[i]) : std::min(result, values[i]);
+    return result;
+}
+
+/**
+ * @brief Lane j of a group of 8 values starts at bit j*bit_width of the group's bit_width bytes
+ */
+struct GroupLayout {
+    //64 bit word of the group lane j starts in, the bit it starts at and 64 minus that bit
+    __m512i word;
+    __m512i shift;
+    __m512i back;
+};
+
+AVX512_KERNEL GroupLayout group_layout(int bit_width) {
+    const int64_t w = bit_width;
+    const __m512i offsets = _mm512_set_epi64(7*w, 6*w, 5*w, 4*w, 3*w, 2*w, w, 0);
+    const __m512i shift = _mm512_and_si512(offsets, _mm512_set1_epi64(63));
+    return {_mm512_srli_epi64(offsets, 6), shift, _mm512_sub_epi64(_mm512_set1_epi64(64), shift)};
+}
+
+/**
+ * @brief Loads 8 deltas minus min_delta zero extended to 64 bit lanes
+ */
+template<typename T>
+AVX512_KERNEL __m512i frame8_avx512(const T *deltas, T min_delta) {
+    if constexpr (sizeof(T) == 8) {
+        return _mm512_sub_epi64(_mm512_loadu_si512(deltas), _mm512_set1_epi64(min_delta));
+    } else {
+        return _mm512_cvtepu32_epi64(_mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(deltas)),
+                                                      _mm256_set1_epi32(min_delta)));
+    }
+}
+
+/**
+ * @brief Shifts the values of a group of 8 into place and assembles the group's output words with
+ *        masked permutes: in round r word k receives the r-th lane that starts in it (low part)
+ *        or spills into it from the word before (high part). A masked store writes the bit_width bytes
+ */
+template<typename T>
+AVX512_KERNEL void pack32_avx512(const T *deltas, T min_delta, int bit_width, uint8_t *out) {
+    if(bit_width == 0) return;
+    const GroupLayout layout = group_layout(bit_width);
+    //the permutes of every round, computed from the same layout
+    __m512i lowIndex[8];
+    std::array<__mmask8, 8> lowMask{};
+    __m512i highIndex[8];
+    std::array<__mmask8, 8> highMask{};
+    int lowRounds{0};
+    int highRounds{0};
+    {
+        std::array<std::array<int64_t, 8>, 8> lowLanes{};
+        std::array<std::array<int64_t, 8>, 8> highLanes{};
+        std::array<int, 8> lowCount{};
+        std::array<int, 8> highCount{};
+        for(int j=0; j<8; ++j) {
+            const int word = (j*bit_width) >> 6;
+            const int shift = (j*bit_width) & 63;
+            const int r = lowCount[word]++;
+            lowLanes[r][word] = j;
+            lowMask[r] |= static_cast<__mmask8>(1u << word);
+            lowRounds = std::max(lowRounds, r+1);
+            if(shift+bit_width > 64) {
+                const int h = highCount[word+1]++;
+                highLanes[h][word+1] = j;
+                highMask[h] |= static_cast<__mmask8>(1u << (word+1));
+                highRounds = std::max(highRounds, h+1);
+            }
+        }
+        for(int r=0; r<8; ++r) {
+            lowIndex[r] = _mm512_loadu_si512(lowLanes[r].data());
+            highIndex[r] = _mm512_loadu_si512(highLanes[r].data());
+        }
+    }
+    const __mmask64 storeMask = bit_width == 64 ? ~__mmask64{0} : (__mmask64{1} << bit_width)-1;
+    for(int g=0; g<4; ++g) {
+        const __m512i v = frame8_avx512(deltas+8*g, min_delta);
+        const __m512i low = _mm512_sllv_epi64(v, layout.shift);
+        const __m512i high = _mm512_srlv_epi64(v, layout.back);
+        __m512i words = _mm512_setzero_si512();
+        for(int r=0; r<lowRounds; ++r) {
+            words = _mm512_or_si512(words, _mm512_maskz_permutexvar_epi64(lowMask[r], lowIndex[r], low));
+        }
+        for(int r=0; r<highRounds; ++r) {
+            words = _mm512_or_si512(words, _mm512_maskz_permutexvar_epi64(highMask[r], highIndex[r], high));
+        }
+        _mm512_mask_storeu_epi8(out+g*bit_width, storeMask, words);
+    }
+}
+
+/**
+ * @brief Loads the bit_width bytes of a group of 8 values with a masked load, so nothing past the
+ *        group is read, and moves the one or two words every value spans into its lane
+ */
+template<typename T>
+AVX512_KERNEL void unpack32_avx512(const uint8_t *in, int bit_width, Unsigned<T> *out) {
+    const GroupLayout layout = group_layout(bit_width);
+    const __m512i nextWord = _mm512_add_epi64(layout.word, _mm512_set1_epi64(1));
+    const __m512i mask = _mm512_set1_epi64(static_cast<int64_t>(low_bits_mask(bit_width)));
+    const __mmask64 loadMask = bit_width == 64 ? ~__mmask64{0} : (__mmask64{1} << bit_width)-1;
+    for(int g=0; g<4; ++g) {
+        const __m512i words = _mm512_maskz_loadu_epi8(loadMask, in+g*bit_width);
+        //a lane starting on a word boundary shifts its next word out completely
+        const __m512i low = _mm512_srlv_epi64(_mm512_permutexvar_epi64(layout.word, words), layout.shift);
+        const __m512i high = _mm512_sllv_epi64(_mm512_permutexvar_epi64(nextWord, words), layout.back);
+        const __m512i v = _mm512_and_si512(_mm512_or_si512(low, high), mask);
+        if constexpr (sizeof(T) == 8) {
+            _mm512_storeu_si512(out+8*g, v);
+        } else {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out+8*g), _mm512_cvtepi64_epi32(v));
+        }
+    }
+}
+
+template<typename T>
+AVX512_KERNEL Unsigned<T> prefix_sum_avx512(const Unsigned<T> *deltas, int count, Unsigned<T> min_delta,
+                                            Unsigned<T> last, T *out) {
+    constexpr int lanes = 64/sizeof(T);
+    const __m512i zero = _mm512_setzero_si512();
+    int i{0};
+    if constexpr (sizeof(T) == 8) {
+        const __m512i minDelta = _mm512_set1_epi64(static_cast<int64_t>(min_delta));
+        __m512i carry = _mm512_set1_epi64(static_cast<int64_t>(last));
+        for(; i+lanes<=count; i+=lanes) {
+            __m512i x = _mm512_add_epi64(_mm512_loadu_si512(deltas+i), minDelta);
+            //alignr with zeros shifts the lanes up by 1, 2 and 4
+            x = _mm512_add_epi64(x, _mm512_alignr_epi64(x, zero, 7));
+            x = _mm512_add_epi64(x, _mm512_alignr_epi64(x, zero, 6));
+            x = _mm512_add_epi64(x, _mm512_alignr_epi64(x, zero, 4));
+            x = _mm512_add_epi64(x, carry);
+            _mm512_storeu_si512(out+i, x);
+            carry = _mm512_permutexvar_epi64(_mm512_set1_epi64(7), x);
+        }
+        last = static_cast<Unsigned<T>>(_mm_cvtsi128_si64(_mm512_castsi512_si128(carry)));
+    } else {
+        const __m512i minDelta = _mm512_set1_epi32(static_cast<int32_t>(min_delta));
+        __m512i carry = _mm512_set1_epi32(static_cast<int32_t>(last));
+        for(; i+lanes<=count; i+=lanes) {
+            __m512i x = _mm512_add_epi32(_mm512_loadu_si512(deltas+i), minDelta);
+            x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 15));
+            x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 14));
+            x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 12));
+            x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 8));
+            x = _mm512_add_epi32(x, carry);
+            _mm512_storeu_si512(out+i, x);
+            carry = _mm512_permutexvar_epi32(_mm512_set1_epi32(15), x);
+        }
+        last = static_cast<Unsigned<T>>(_mm_cvtsi128_si32(_mm512_castsi512_si128(carry)));
+    }
+    return prefix_sum_scalar(deltas+i, count-i, min_delta, last, out+i);
+}
+
+#endif
+
+/**
+ * @throw std::invalid_argument if the CPU does not support the level
+ */
+void check_level(SimdLevel level) {
+    if(static_cast<int>(level) > static_cast<int>(detect_simd_level())) {
+        throw std::invalid_argument(std::string("SIMD level ") + simd_level_name(level) + " is not supported");
+    }
+}
+
+template<typename T>
+EncodeKernels<T> encode_kernels(SimdLevel level) {
+    check_level(level);
+#if defined(__x86_64__)
+    if(level == SimdLevel::Avx512) {
+        return {deltas_avx512<T>, extreme_avx512<T, false>, extreme_avx512<T, true>, pack32_avx512<T>};
+    }
+    if(level == SimdLevel::Avx2) {
+        return {deltas_avx2<T>, extreme_avx2<T, false>, extreme_avx2<T, true>, pack32_avx2<T>};
+    }
+#endif
+    return {deltas_scalar<T>, min_scalar<T>, max_scalar<T>, pack32_scalar<T>};
+}
+
+template<typename T>
+DecodeKernels<T> decode_kernels(SimdLevel level, UnpackKernel unpack) {
+    check_level(level);
+    DecodeKernels<T> kernels{unpack32_scalar<T>, prefix_sum_scalar<T>};
+#if defined(__x86_64__)
+    if(level == SimdLevel::Avx512) kernels = {unpack32_avx512<T>, prefix_sum_avx512<T>};
+    if(level == SimdLevel::Avx2) kernels = {unpack32_avx2<T>, prefix_sum_avx2<T>};
+#endif
+    if(unpack == UnpackKernel::Specialized) kernels.unpack32 = unpack32_specialized<T>;
+    return kernels;
+}
+
+void check_capacity(const DeltaPageHeader &header, int64_t capacity) {
+    if(header.value_count > capacity) {
+        throw std::runtime_error("DELTA_BINARY_PACKED page holds " + std::to_string(header.value_count)
+                                 + " values, more than the " + std::to_string(capacity) + " expected");
+    }
+}
+
+/**
+ * @brief Sink of decode_blocks that writes the values to the output
+ */
+template<typename T>
+struct MaterializeSink {
+    T *out;
+
+    T *group(int64_t first) { return out+first; }
+    void done(int64_t, int) {}
+};
+
+/**
+ * @brief Selection bits of up to 32 values, bit i is set if lo <= values[i] <= hi
+ */
+template<typename T>
+uint32_t range_mask(const T *values, int count, T lo, T hi) {
+    uint32_t mask{0};
+    for(int i=0; i<count; ++i) mask |= static_cast<uint32_t>(lo <= values[i] && values[i] <= hi) << i;
+    return mask;
+}
+
+/**
+ * @brief ORs the count bits of mask into the bitmap from bit first on
+ */
+void or_bits(uint8_t *bitmap, int64_t first, uint32_t mask, int count) {
+    const int shift = static_cast<int>(first & 7);
+    const uint64_t word = static_cast<uint64_t>(mask) << shift;
+    uint8_t *bytes = bitmap+(first >> 3);
+    for(int b=0; b<(shift+count+7)/8; ++b) bytes[b] |= static_cast<uint8_t>(word >> 8*b);
+}
+
+/**
+ * @brief Sink of decode_blocks that keeps only the selection bits of every group
+ */
+template<typename T>
+struct FilterSink {
+    T lo;
+    T hi;
+    uint8_t *selection;
+    int64_t selected{0};
+    alignas(64) std::array<T, 32> values{};
+
+    T *group(int64_t) { return values.data(); }
+    void done(int64_t first, int count) {
+        const uint32_t mask = range_mask(values.data(), count, lo, hi);
+        or_bits(selection, first, mask, count);
+        selected += __builtin_popcount(mask);
+    }
+};
+
+/**
+ * @brief Sink of decode_blocks that keeps only the aggregate
+ */
+template<typename T>
+struct AggregateSink {
+    DeltaAggregate<T> aggregate;
+    alignas(64) std::array<T, 32> values{};
+
+    T *group(int64_t) { return values.data(); }
+    void done(int64_t, int count) {
+        for(int i=0; i<count; ++i) {
+            aggregate.min = std::min(aggregate.min, values[i]);
+            aggregate.max = std::max(aggregate.max, values[i]);
+            aggregate.sum = static_cast<int64_t>(static_cast<uint64_t>(aggregate.sum)+static_cast<uint64_t>(values[i]));
+        }
+        aggregate.count += count;
+    }
+};
+
+/**
+ * @brief Decodes the values [begin, stop) from the blocks starting at pos, begin is the first value
+ *        of a block. The running sum continues from last. Every group of up to 32 values is
+ *        reconstructed into sink.group(first) and handed over with sink.done(first, count)
+ *
+ * @return the last value decoded
+ */
+template<typename T, typename Sink>
+Unsigned<T> decode_blocks(const DecodeKernels<T> &kernels, const DeltaPageHeader &header, const uint8_t *pos,
+                          const uint8_t *end, int64_t begin, int64_t stop, Unsigned<T> last, Sink &sink) {
+    using UT = Unsigned<T>;
+    int64_t decoded{begin};
+    alignas(64) std::array<UT, 32> deltas;
+    //copy of the groups at the end of the page, the kernels read past them
+    alignas(64) std::array<uint8_t, 4*64+unpackOverread> padded;
+    while(decoded < stop) {
+        uint64_t zigzag;
+        if(!get_uleb128(pos, end, zigzag)) throw corrupt_page("truncated block header");
+        const UT minDelta = static_cast<UT>(unzigzag(zigzag));
+        if(end-pos < header.miniblocks_per_block) throw corrupt_page("truncated bit widths");
+        const uint8_t *bitWidths = pos;
+        pos += header.miniblocks_per_block;
+        for(int64_t m=0; m<header.miniblocks_per_block && decoded < stop; ++m) {
+            const int bitWidth = bitWidths[m];
+            if(bitWidth > static_cast<int>(8*sizeof(T))) {
+                throw corrupt_page("bit width " + std::to_string(bitWidth) + " of a " + std::to_string(8*sizeof(T))
+                                   + " bit column");
+            }
+            const int64_t groupBytes = 4*bitWidth;
+            for(int64_t g=0; g<header.values_per_miniblock() && decoded < stop; g+=32) {
+                const int n = static_cast<int>(std::min<int64_t>(32, stop-decoded));
+                const uint8_t *group = pos;
+                const int64_t available = end-pos;
+                if(available < groupBytes+unpackOverread) {
+                    if(available < (n*bitWidth+7)/8) throw corrupt_page("truncated miniblock");
+                    const int64_t copied = std::min(groupBytes, available);
+                    std::memcpy(padded.data(), pos, copied);
+                    std::fill(padded.begin()+copied, padded.end(), 0);
+                    group = padded.data();
+                }
+                kernels.unpack32(group, bitWidth, deltas.data());
+                last = kernels.prefix_sum(deltas.data(), n, minDelta, last, sink.group(decoded));
+                sink.done(decoded, n);
+                decoded += n;
+                pos += std::min(groupBytes, available);
+            }
+        }
+    }
+    return last;
+}
+
+/**
+ * @brief Runs fn(t) for every t in [0, threads) on its own thread, t = 0 on the calling one, and
+ *        rethrows the first exception thrown
+ */
+template<typename Fn>
+void run_on_threads(int threads, Fn fn) {
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    auto worker = [&](int t) {
+        try {
+            fn(t);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if(!error) error = std::current_exception();
+        }
+    };
+    std::vector<std::thread> pool;
+    for(int t=1; t<threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for(auto &thread : pool) thread.join();
+    if(error) std::rethrow_exception(error);
+}
+
+} // namespace
+
+SimdLevel detect_simd_level() {
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return SimdLevel::Avx512;
+    if(__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+std::vector<SimdLevel> supported_simd_levels() {
+    std::vector<SimdLevel> levels;
+    for(auto level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if(static_cast<int>(level) <= static_cast<int>(detect_simd_level())) levels.push_back(level);
+    }
+    return levels;
+}
+
+const char *simd_level_name(SimdLevel level) {
+    switch(level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::Avx2: return "avx2";
+        case SimdLevel::Avx512: return "avx512";
+    }
+    return "unknown";
+}
+
+const char *unpack_kernel_name(UnpackKernel kernel) {
+    return kernel == UnpackKernel::Specialized ? "specialized" : "generic";
+}
+
+SimdLevel parse_simd_level(const std::string &name) {
+    for(auto level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if(name != simd_level_name(level)) continue;
+        check_level(level);
+        return level;
+    }
+    throw std::invalid_argument("Unknown SIMD level: " + name + " (expected scalar, avx2 or avx512)");
+}
+
+DeltaPageHeader parse_delta_header(const uint8_t *data, int64_t size) {
+    const uint8_t *pos = data;
+    const uint8_t *end = data+size;
+    std::array<uint64_t, 4> fields;
+    for(auto &field : fields) {
+        if(!get_uleb128(pos, end, field)) throw corrupt_page("truncated header");
+    }
+    DeltaPageHeader header;
+    header.block_size = static_cast<int64_t>(fields[0]);
+    header.miniblocks_per_block = static_cast<int64_t>(fields[1]);
+    header.value_count = static_cast<int64_t>(fields[2]);
+    header.first_value = unzigzag(fields[3]);
+    header.size = pos-data;
+    if(fields[0] == 0 || fields[0] % 128 != 0 || fields[0] > (uint64_t{1} << 31) || fields[1] == 0
+       || fields[0] % fields[1] != 0 || header.values_per_miniblock() % 32 != 0) {
+        throw corrupt_page("block size " + std::to_string(fields[0]) + " with " + std::to_string(fields[1])
+                           + " miniblocks");
+    }
+    if(fields[2] > static_cast<uint64_t>(INT64_MAX)) throw corrupt_page("invalid value count");
+    return header;
+}
+
+int64_t miniblock_count(const std::vector<int64_t> &bit_widths) {
+    int64_t count{0};
+    for(int64_t miniblocks : bit_widths) count += miniblocks;
+    return count;
+}
+
+double mean_bit_width(const std::vector<int64_t> &bit_widths) {
+    const int64_t miniblocks = miniblock_count(bit_widths);
+    int64_t bits{0};
+    for(size_t width=0; width<bit_widths.size(); ++width) bits += static_cast<int64_t>(width)*bit_widths[width];
+    return miniblocks > 0 ? static_cast<double>(bits)/miniblocks : 0;
+}
+
+DeltaPageLayout inspect_delta_page(const uint8_t *data, int64_t size) {
+    DeltaPageLayout layout;
+    layout.header = parse_delta_header(data, size);
+    const int64_t perMiniblock = layout.header.values_per_miniblock();
+    const uint8_t *pos = data+layout.header.size;
+    const uint8_t *end = data+size;
+    //the first value is stored in the header
+    int64_t remaining = std::max<int64_t>(layout.header.value_count-1, 0);
+    while(remaining > 0) {
+        layout.block_offsets.push_back(pos-data);
+        uint64_t zigzag;
+        if(!get_uleb128(pos, end, zigzag)) throw corrupt_page("truncated block header");
+        if(end-pos < layout.header.miniblocks_per_block) throw corrupt_page("truncated bit widths");
+        const uint8_t *bitWidths = pos;
+        pos += layout.header.miniblocks_per_block;
+        for(int64_t m=0; m<layout.header.miniblocks_per_block && remaining > 0; ++m) {
+            const int bitWidth = bitWidths[m];
+            if(bitWidth > 64) throw corrupt_page("bit width " + std::to_string(bitWidth));
+            ++layout.bit_widths[bitWidth];
+            const int64_t n = std::min(remaining, perMiniblock);
+            const int64_t available = end-pos;
+            if(available < (n*bitWidth+7)/8) throw corrupt_page("truncated miniblock");
+            pos += std::min(perMiniblock*bitWidth/8, available);
+            remaining -= n;
+        }
+    }
+    return layout;
+}
+
+template<typename T>
+int64_t delta_encode(const T *values, int64_t value_count, std::vector<uint8_t> &buffer, SimdLevel level) {
+    using UT = Unsigned<T>;
+    const EncodeKernels<T> kernels = encode_kernels<T>(level);
+    constexpr int blockSize = deltaBlockSize<T>;
+    constexpr int valuesPerMiniblock = miniblockSize<T>;
+    const int64_t blockCount = value_count > 1 ? (value_count-1+blockSize-1)/blockSize : 0;
+    //every varint takes at most 10 bytes
+    const size_t maxSize = 4*10 + blockCount*(10+deltaMiniblocksPerBlock+blockSize*sizeof(T));
+    if(buffer.size() < maxSize) buffer.resize(maxSize);
+    uint8_t *out = buffer.data();
+    out = put_uleb128(out, blockSize);
+    out = put_uleb128(out, deltaMiniblocksPerBlock);
+    out = put_uleb128(out, static_cast<uint64_t>(value_count));
+    out = put_zigzag(out, value_count > 0 ? static_cast<int64_t>(values[0]) : 0);
+    alignas(64) std::array<T, blockSize> deltas;
+    alignas(64) std::array<T, valuesPerMiniblock> padded;
+    for(int64_t start=1; start<value_count; start+=blockSize) {
+        const int count = static_cast<int>(std::min<int64_t>(blockSize, value_count-start));
+        kernels.deltas(values+start-1, count, deltas.data());
+        const T minDelta = kernels.min(deltas.data(), count);
+        out = put_zigzag(out, static_cast<int64_t>(minDelta));
+        uint8_t *bitWidths = out;
+        out += deltaMiniblocksPerBlock;
+        for(int m=0; m<deltaMiniblocksPerBlock; ++m) {
+            const int first = m*valuesPerMiniblock;
+            //miniblocks without values are left out, their bit width is written as 0
+            if(first >= count) {
+                bitWidths[m] = 0;
+                continue;
+            }
+            const int n = std::min(valuesPerMiniblock, count-first);
+            const T maxDelta = kernels.max(deltas.data()+first, n);
+            const int bitWidth = required_bits(static_cast<UT>(static_cast<UT>(maxDelta)-static_cast<UT>(minDelta)));
+            bitWidths[m] = static_cast<uint8_t>(bitWidth);
+            const T *miniblock = deltas.data()+first;
+            if(n < valuesPerMiniblock) {
+                //padding with the min delta packs zeros, as Arrow pads the last miniblock
+                std::copy(miniblock, miniblock+n, padded.begin());
+                std::fill(padded.begin()+n, padded.end(), minDelta);
+                miniblock = padded.data();
+            }
+            for(int g=0; g<valuesPerMiniblock; g+=32) {
+                kernels.pack32(miniblock+g, minDelta, bitWidth, out);
+                out += 4*bitWidth;
+            }
+        }
+    }
+    return out-buffer.data();
+}
+
+template<typename T>
+int64_t delta_decode(const uint8_t *data, int64_t size, T *out, int64_t capacity, SimdLevel level,
+                     UnpackKernel unpack) {
+    using UT = Unsigned<T>;
+    const DecodeKernels<T> kernels = decode_kernels<T>(level, unpack);
+    const DeltaPageHeader header = parse_delta_header(data, size);
+    check_capacity(header, capacity);
+    if(header.value_count == 0) return 0;
+    out[0] = static_cast<T>(header.first_value);
+    MaterializeSink<T> sink{out};
+    decode_blocks(kernels, header, data+header.size, data+size, 1, header.value_count,
+                  static_cast<UT>(header.first_value), sink);
+    return header.value_count;
+}
+
+template<typename T>
+int64_t delta_decode_parallel(const uint8_t *data, int64_t size, T *out, int64_t capacity, SimdLevel level,
+                              int threads) {
+    using UT = Unsigned<T>;
+    const DecodeKernels<T> kernels = decode_kernels<T>(level, UnpackKernel::Generic);
+    //pre-scan: the blocks are located by their headers, the miniblocks are skipped
+    const DeltaPageLayout layout = inspect_delta_page(data, size);
+    const DeltaPageHeader &header = layout.header;
+    check_capacity(header, capacity);
+    if(header.value_count == 0) return 0;
+    out[0] = static_cast<T>(header.first_value);
+    const int64_t blocks = static_cast<int64_t>(layout.block_offsets.size());
+    if(threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+    threads = static_cast<int>(std::clamp<int64_t>(threads, 1, std::max<int64_t>(blocks, 1)));
+    //range t holds the blocks [t*blocks/threads, (t+1)*blocks/threads)
+    auto firstBlock = [&](int t) { return t*blocks/threads; };
+    auto firstValue = [&](int64_t block) { return std::min(1+block*header.block_size, header.value_count); };
+    //the running sum at the end of every range, relative to its start except for the first range
+    std::vector<UT> rangeLast(threads);
+    run_on_threads(threads, [&](int t) {
+        const int64_t block = firstBlock(t);
+        if(block == firstBlock(t+1)) return;
+        //the first range starts at the first value and needs no fix-up
+        const UT start = t == 0 ? static_cast<UT>(header.first_value) : 0;
+        MaterializeSink<T> sink{out};
+        rangeLast[t] = decode_blocks(kernels, header, data+layout.block_offsets[block], data+size,
+                                     firstValue(block), firstValue(firstBlock(t+1)), start, sink);
+    });
+    if(threads == 1) return header.value_count;
+    //the value every range continues from, serial over the few ranges
+    std::vector<UT> rangeStart(threads);
+    for(int t=1; t<threads; ++t) rangeStart[t] = static_cast<UT>(rangeStart[t-1]+rangeLast[t-1]);
+    run_on_threads(threads-1, [&](int t) {
+        const int range = t+1;
+        const UT offset = rangeStart[range];
+        for(int64_t i=firstValue(firstBlock(range)); i<firstValue(firstBlock(range+1)); ++i) {
+            out[i] = static_cast<T>(static_cast<UT>(out[i])+offset);
+        }
+    });
+    return header.value_count;
+}
+
+template<typename T>
+int64_t delta_decode_filter(const uint8_t *data, int64_t size, T lo, T hi, uint8_t *selection, int64_t capacity,
+                            SimdLevel level) {
+    using UT = Unsigned<T>;
+    const DecodeKernels<T> kernels = decode_kernels<T>(level, UnpackKernel::Generic);
+    const DeltaPageHeader header = parse_delta_header(data, size);
+    check_capacity(header, capacity);
+    std::fill(selection, selection+(header.value_count+7)/8, 0);
+    if(header.value_count == 0) return 0;
+    FilterSink<T> sink{lo, hi, selection};
+    sink.values[0] = static_cast<T>(header.first_value);
+    sink.done(0, 1);
+    decode_blocks(kernels, header, data+header.size, data+size, 1, header.value_count,
+                  static_cast<UT>(header.first_value), sink);
+    return sink.selected;
+}
+
+template<typename T>
+DeltaAggregate<T> delta_decode_aggregate(const uint8_t *data, int64_t size, SimdLevel level) {
+    using UT = Unsigned<T>;
+    const DecodeKernels<T> kernels = decode_kernels<T>(level, UnpackKernel::Generic);
+    const DeltaPageHeader header = parse_delta_header(data, size);
+    AggregateSink<T> sink;
+    if(header.value_count == 0) return sink.aggregate;
+    sink.values[0] = static_cast<T>(header.first_value);
+    sink.done(0, 1);
+    decode_blocks(kernels, header, data+header.size, data+size, 1, header.value_count,
+                  static_cast<UT>(header.first_value), sink);
+    return sink.aggregate;
+}
+
+template<typename T>
+int64_t select_range(const T *values, int64_t value_count, T lo, T hi, uint8_t *selection) {
+    std::fill(selection, selection+(value_count+7)/8, 0);
+    int64_t selected{0};
+    for(int64_t first=0; first<value_count; first+=32) {
+        const int count = static_cast<int>(std::min<int64_t>(32, value_count-first));
+        const uint32_t mask = range_mask(values+first, count, lo, hi);
+        or_bits(selection, first, mask, count);
+        selected += __builtin_popcount(mask);
+    }
+    return selected;
+}
+
+template<typename T>
+DeltaAggregate<T> aggregate_values(const T *values, int64_t value_count) {
+    DeltaAggregate<T> aggregate;
+    for(int64_t i=0; i<value_count; ++i) {
+        aggregate.min = std::min(aggregate.min, values[i]);
+        aggregate.max = std::max(aggregate.max, values[i]);
+        aggregate.sum = static_cast<int64_t>(static_cast<uint64_t>(aggregate.sum)+static_cast<uint64_t>(values[i]));
+    }
+    aggregate.count = value_count;
+    return aggregate;
+}
+
+template int64_t delta_encode<int32_t>(const int32_t *, int64_t, std::vector<uint8_t> &, SimdLevel);
+template int64_t delta_encode<int64_t>(const int64_t *, int64_t, std::vector<uint8_t> &, SimdLevel);
+template int64_t delta_decode<int32_t>(const uint8_t *, int64_t, int32_t *, int64_t, SimdLevel, UnpackKernel);
+template int64_t delta_decode<int64_t>(const uint8_t *, int64_t, int64_t *, int64_t, SimdLevel, UnpackKernel);
+template int64_t delta_decode_parallel<int32_t>(const uint8_t *, int64_t, int32_t *, int64_t, SimdLevel, int);
+template int64_t delta_decode_parallel<int64_t>(const uint8_t *, int64_t, int64_t *, int64_t, SimdLevel, int);
+template int64_t delta_decode_filter<int32_t>(const uint8_t *, int64_t, int32_t, int32_t, uint8_t *, int64_t, SimdLevel);
+template int64_t delta_decode_filter<int64_t>(const uint8_t *, int64_t, int64_t, int64_t, uint8_t *, int64_t, SimdLevel);
+template DeltaAggregate<int32_t> delta_decode_aggregate<int32_t>(const uint8_t *, int64_t, SimdLevel);
+template DeltaAggregate<int64_t> delta_decode_aggregate<int64_t>(const uint8_t *, int64_t, SimdLevel);
+template int64_t select_range<int32_t>(const int32_t *, int64_t, int32_t, int32_t, uint8_t *);
+template int64_t select_range<int64_t>(const int64_t *, int64_t, int64_t, int64_t, uint8_t *);
+template DeltaAggregate<int32_t> aggregate_values<int32_t>(const int32_t *, int64_t);
+template DeltaAggregate<int64_t> aggregate_values<int64_t>(const int64_t *, int64_t);
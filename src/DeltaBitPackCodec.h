@@ -0,0 +1,224 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Instruction set the kernels of the reference DELTA_BINARY_PACKED codec run with
+ */
+enum class SimdLevel {
+    Scalar,
+    Avx2,  ///< AVX2, unpacking with gathers
+    Avx512 ///< AVX-512 F and BW, unpacking with permutes of masked loads
+};
+
+/**
+ * @brief The best level both the CPU and the compiler support, Scalar on other architectures
+ */
+SimdLevel detect_simd_level();
+
+/**
+ * @brief Every level up to detect_simd_level() in increasing order
+ */
+std::vector<SimdLevel> supported_simd_levels();
+
+/**
+ * @brief "scalar", "avx2" or "avx512"
+ */
+const char *simd_level_name(SimdLevel level);
+
+/**
+ * @brief How the decoder unpacks the miniblocks
+ */
+enum class UnpackKernel {
+    Generic,    ///< the kernel of the SIMD level, the bit width is a runtime parameter
+    Specialized ///< a scalar kernel instantiated per bit width, fully unrolled with constant shifts
+};
+
+/**
+ * @brief "generic" or "specialized"
+ */
+const char *unpack_kernel_name(UnpackKernel kernel);
+
+/**
+ * @brief Parses a name as returned by simd_level_name
+ *
+ * @throw std::invalid_argument for unknown names and levels this CPU does not support
+ */
+SimdLevel parse_simd_level(const std::string &name);
+
+//block layout the reference encoder writes, the same as Arrow's DeltaBitPackEncoder: blocks of 128
+//INT32 or 256 INT64 values in 4 miniblocks
+template<typename T>
+constexpr int deltaBlockSize{sizeof(T) == 4 ? 128 : 256};
+constexpr int deltaMiniblocksPerBlock{4};
+
+/**
+ * @brief The header a DELTA_BINARY_PACKED page starts with
+ */
+struct DeltaPageHeader {
+    int64_t block_size;
+    int64_t miniblocks_per_block;
+    int64_t value_count;
+    //zigzag decoded, wraps into the range of the column type
+    int64_t first_value;
+    //size of the header in bytes, the first block starts there
+    int64_t size;
+
+    int64_t values_per_miniblock() const { return block_size/miniblocks_per_block; }
+};
+
+/**
+ * @brief Reads the header of a DELTA_BINARY_PACKED page
+ *
+ * @throw std::runtime_error if the header is truncated or its block layout is not allowed by the
+ *        specification (blocks of a multiple of 128 values, miniblocks of a multiple of 32 values)
+ */
+DeltaPageHeader parse_delta_header(const uint8_t *data, int64_t size);
+
+/**
+ * @brief Block structure of a DELTA_BINARY_PACKED page
+ */
+struct DeltaPageLayout {
+    DeltaPageHeader header;
+    //offset of every block in the page in bytes, block b holds the values from 1+b*block_size on
+    std::vector<int64_t> block_offsets;
+    //number of miniblocks holding values per bit width, indexed by the width up to 64. Miniblocks
+    //after the last value are not written and not counted
+    std::vector<int64_t> bit_widths = std::vector<int64_t>(65);
+};
+
+/**
+ * @brief Number of miniblocks counted in a bit width histogram like DeltaPageLayout::bit_widths
+ */
+int64_t miniblock_count(const std::vector<int64_t> &bit_widths);
+
+/**
+ * @brief Mean bit width of the miniblocks counted in a bit width histogram, 0 if there are none
+ */
+double mean_bit_width(const std::vector<int64_t> &bit_widths);
+
+/**
+ * @brief Walks the block headers of a DELTA_BINARY_PACKED page, e.g. one returned by FlushValues,
+ *        and counts the bit widths the encoder picked. The miniblocks are skipped, not unpacked
+ *
+ * @throw std::runtime_error if the page is corrupt
+ */
+DeltaPageLayout inspect_delta_page(const uint8_t *data, int64_t size);
+
+/**
+ * @brief Spec-compliant DELTA_BINARY_PACKED encoder independent of Arrow. It writes the same block
+ *        layout and picks the same min delta and bit widths as Arrow's DeltaBitPackEncoder, so its
+ *        pages are byte-for-byte identical to those returned by FlushValues
+ *
+ * @tparam T int32_t or int64_t
+ * @param values The values to encode
+ * @param value_count The number of values
+ * @param buffer Receives the page in its first bytes. It is grown to the largest size a page of
+ *               value_count values can take and never shrunk, so a reused buffer is not reallocated
+ * @param level The kernels to encode with, at most detect_simd_level()
+ * @return int64_t the size of the page in bytes
+ * @throw std::invalid_argument if the CPU does not support the level
+ */
+template<typename T>
+int64_t delta_encode(const T *values, int64_t value_count, std::vector<uint8_t> &buffer, SimdLevel level);
+
+/**
+ * @brief Decodes a whole DELTA_BINARY_PACKED page of any spec-compliant block layout
+ *
+ * @tparam T int32_t or int64_t
+ * @param data, size The page
+ * @param out Receives the values
+ * @param capacity The number of values out can hold
+ * @param level The kernels to decode with, at most detect_simd_level()
+ * @param unpack The unpack kernels, Specialized replaces the unpacking of the level, the prefix
+ *               sum stays that of the level
+ * @return int64_t the number of values decoded, the value count of the header
+ * @throw std::runtime_error if the page is corrupt or holds more than capacity values,
+ *        std::invalid_argument if the CPU does not support the level
+ */
+template<typename T>
+int64_t delta_decode(const uint8_t *data, int64_t size, T *out, int64_t capacity, SimdLevel level,
+                     UnpackKernel unpack = UnpackKernel::Generic);
+
+/**
+ * @brief Decodes a DELTA_BINARY_PACKED page on several threads. The block headers are pre-scanned
+ *        with inspect_delta_page, every thread unpacks a contiguous range of blocks to a running sum
+ *        that starts at 0, and a second parallel pass adds the last value of the preceding ranges to
+ *        every range but the first. The threads are started per call, see delta_decode
+ *
+ * @param threads The number of threads, at most one per block, hardware concurrency if 0 or less
+ */
+template<typename T>
+int64_t delta_decode_parallel(const uint8_t *data, int64_t size, T *out, int64_t capacity, SimdLevel level,
+                              int threads);
+
+/**
+ * @brief Minimum, maximum and sum of a set of values
+ */
+template<typename T>
+struct DeltaAggregate {
+    int64_t count{0};
+    T min{std::numeric_limits<T>::max()};
+    T max{std::numeric_limits<T>::min()};
+    //wraps on overflow
+    int64_t sum{0};
+
+    bool operator==(const DeltaAggregate &other) const {
+        return count == other.count && min == other.min && max == other.max && sum == other.sum;
+    }
+};
+
+/**
+ * @brief Decodes a DELTA_BINARY_PACKED page into a selection bitmap without materializing the
+ *        values: every group of 32 values is reconstructed into a local buffer and compared to the
+ *        range right away, see delta_decode
+ *
+ * @param lo, hi The range of the predicate, inclusive
+ * @param selection Receives one bit per value, LSB first, set if lo <= value <= hi. The first
+ *                  (value count+7)/8 bytes are overwritten
+ * @return int64_t the number of selected values
+ */
+template<typename T>
+int64_t delta_decode_filter(const uint8_t *data, int64_t size, T lo, T hi, uint8_t *selection, int64_t capacity,
+                            SimdLevel level);
+
+/**
+ * @brief Decodes a DELTA_BINARY_PACKED page into the minimum, maximum and sum of its values without
+ *        materializing them, see delta_decode_filter
+ */
+template<typename T>
+DeltaAggregate<T> delta_decode_aggregate(const uint8_t *data, int64_t size, SimdLevel level);
+
+/**
+ * @brief The range predicate of delta_decode_filter over decoded values, the second pass of a
+ *        decode-then-filter scan
+ *
+ * @return int64_t the number of selected values
+ */
+template<typename T>
+int64_t select_range(const T *values, int64_t value_count, T lo, T hi, uint8_t *selection);
+
+/**
+ * @brief The aggregate of delta_decode_aggregate over decoded values
+ */
+template<typename T>
+DeltaAggregate<T> aggregate_values(const T *values, int64_t value_count);
+
+extern template int64_t delta_encode<int32_t>(const int32_t *, int64_t, std::vector<uint8_t> &, SimdLevel);
+extern template int64_t delta_encode<int64_t>(const int64_t *, int64_t, std::vector<uint8_t> &, SimdLevel);
+extern template int64_t delta_decode<int32_t>(const uint8_t *, int64_t, int32_t *, int64_t, SimdLevel, UnpackKernel);
+extern template int64_t delta_decode<int64_t>(const uint8_t *, int64_t, int64_t *, int64_t, SimdLevel, UnpackKernel);
+extern template int64_t delta_decode_parallel<int32_t>(const uint8_t *, int64_t, int32_t *, int64_t, SimdLevel, int);
+extern template int64_t delta_decode_parallel<int64_t>(const uint8_t *, int64_t, int64_t *, int64_t, SimdLevel, int);
+extern template int64_t delta_decode_filter<int32_t>(const uint8_t *, int64_t, int32_t, int32_t, uint8_t *, int64_t,
+                                                     SimdLevel);
+extern template int64_t delta_decode_filter<int64_t>(const uint8_t *, int64_t, int64_t, int64_t, uint8_t *, int64_t,
+                                                     SimdLevel);
+extern template DeltaAggregate<int32_t> delta_decode_aggregate<int32_t>(const uint8_t *, int64_t, SimdLevel);
+extern template DeltaAggregate<int64_t> delta_decode_aggregate<int64_t>(const uint8_t *, int64_t, SimdLevel);
+extern template int64_t select_range<int32_t>(const int32_t *, int64_t, int32_t, int32_t, uint8_t *);
+extern template int64_t select_range<int64_t>(const int64_t *, int64_t, int64_t, int64_t, uint8_t *);
+extern template DeltaAggregate<int32_t> aggregate_values<int32_t>(const int32_t *, int64_t);
+extern template DeltaAggregate<int64_t> aggregate_values<int64_t>(const int64_t *, int64_t);
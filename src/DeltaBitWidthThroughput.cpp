@@ -0,0 +1,124 @@
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "parquet/types.h"
+
+#include "BenchmarkClock.h"
+#include "DeltaBitPackCodec.h"
+#include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+/**
+ * @brief Generates values whose DELTA_BINARY_PACKED miniblocks all have the given bit width: every
+ *        delta is the smallest value of T plus a random offset of bit_width bits, and every miniblock
+ *        holds the offsets 0 and 2^bit_width-1, so the min delta of every block is the smallest value
+ *        of T and every miniblock spans exactly bit_width bits. A last miniblock with a single delta
+ *        has bit width 0
+ */
+template<typename T>
+std::vector<T> generate_bit_width(int64_t value_count, int bit_width, uint64_t seed) {
+    using UT = std::make_unsigned_t<T>;
+    constexpr int miniblockSize{deltaBlockSize<T>/deltaMiniblocksPerBlock};
+    const uint64_t mask = bit_width == 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t{1} << bit_width)-1;
+    const UT minDelta = static_cast<UT>(std::numeric_limits<T>::min());
+    Xoshiro256 rng(seed);
+    std::vector<T> values(value_count);
+    UT value = static_cast<UT>(rng.next());
+    for(int64_t i=0; i<value_count; ++i) {
+        if(i > 0) {
+            //the first value is stored in the header, delta i-1 leads to value i
+            const int64_t position = (i-1) % miniblockSize;
+            const uint64_t offset = position == 0 ? 0 : position == 1 ? mask : rng.below_or_equal(mask);
+            value = static_cast<UT>(value + minDelta + static_cast<UT>(offset));
+        }
+        values[i] = static_cast<T>(value);
+    }
+    return values;
+}
+
+/**
+ * @brief Measures the decoding of Arrow's DELTA_BINARY_PACKED codec and of the reference codec with
+ *        the generic and the per bit width unpack kernels at every SIMD level for every bit width of
+ *        the type, and prints and writes one record each
+ *
+ * @tparam DType parquet::Int32Type or parquet::Int64Type
+ * @param options The number of warm-up and measured repetitions
+ * @param value_count The number of values per page
+ * @param levels The SIMD levels to measure the reference codec with
+ * @param results The results to write to
+ */
+template<typename DType>
+void sweep_bit_widths(const RoundtripOptions &options, int64_t value_count, const std::vector<SimdLevel> &levels,
+                      ResultsWriter &results) {
+    using T = typename DType::c_type;
+    const std::string typeName = parquet::TypeToString(DType::type_num);
+    for(int bitWidth=0; bitWidth<=8*static_cast<int>(sizeof(T)); ++bitWidth) {
+        const std::vector<T> in_data = generate_bit_width<T>(value_count, bitWidth, 42+bitWidth);
+        const RoundtripResult arrow = encoder_roundtrip<DType>(options, in_data, parquet::Encoding::DELTA_BINARY_PACKED);
+        auto report = [&](const std::string &codec, const RoundtripResult &result) {
+            // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+            const double decMbS = static_cast<double>(result.input_bytes)*1000/result.decode.median;
+            const double decodeSpeedup = arrow.decode.median/result.decode.median;
+            const int64_t miniblocks = miniblock_count(result.bit_widths);
+            const double share = miniblocks > 0 ? static_cast<double>(result.bit_widths.at(bitWidth))/miniblocks : 0;
+            std::cout << typeName << '\t' << bitWidth << '\t' << codec << '\t' << result.decode_ns_per_value()
+                        << '\t' << result.decode_cycles_per_value() << '\t' << decMbS << '\t' << decodeSpeedup
+                        << '\t' << 100*share << "%\n";
+
+            ResultRecord record;
+            record.set("type", typeName).set("bit_width", bitWidth)
+                  .set("encoding", parquet::EncodingToString(parquet::Encoding::DELTA_BINARY_PACKED))
+                  .set("codec", codec).set("decode_speedup", decodeSpeedup).set("bit_width_share", share);
+            add_roundtrip_fields(record, result);
+            results.write(record);
+        };
+        report("arrow", arrow);
+        for(SimdLevel level : levels) {
+            for(UnpackKernel unpack : {UnpackKernel::Generic, UnpackKernel::Specialized}) {
+                report(std::string("reference-") + simd_level_name(level) + "-" + unpack_kernel_name(unpack),
+                       reference_delta_roundtrip(options, in_data.data(), value_count, level, unpack));
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if(argc != 2) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0] << " <Number of Values to write>\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count) || value_count < 1) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    //_______________Parsing_done_______________
+    RoundtripOptions options;
+    options.warmup = 3;
+    options.sample_repeat = 20;
+    const std::vector<SimdLevel> levels = supported_simd_levels();
+
+    std::cout << "Time stamp counter runs at " << tsc_ticks_per_ns() << "GHz, cycles are counted in its ticks\n"
+                << "Reference codec up to " << simd_level_name(detect_simd_level()) << ", speedups relative to Arrow\n"
+                << "type\tbit width\tcodec\tdecode ns/value\tdecode cycles/value\tdecode MB/s\tdecode speedup"
+                << "\tminiblocks at bit width\n";
+    try {
+        ResultsWriter results("DeltaBitWidthThroughput", argc, argv);
+        sweep_bit_widths<parquet::Int32Type>(options, value_count, levels, results);
+        sweep_bit_widths<parquet::Int64Type>(options, value_count, levels, results);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,107 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "parquet/types.h"
+
+#include "BenchmarkClock.h"
+#include "DeltaBitPackCodec.h"
+#include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+/**
+ * @brief Measures Arrow's DELTA_BINARY_PACKED codec and the reference codec at every SIMD level on
+ *        the same data and prints and writes one record each. Arrow's first page is cross-validated
+ *        against the reference codec by encoder_roundtrip
+ *
+ * @tparam DType parquet::Int32Type or parquet::Int64Type
+ * @param options The number of warm-up and measured repetitions
+ * @param in_data The values to use for the roundtrips
+ * @param spec The workload the data was generated with, written to the results
+ * @param levels The SIMD levels to measure the reference codec with
+ * @param results The results to write to
+ */
+template<typename DType>
+void compare_codecs(const RoundtripOptions &options, const std::vector<typename DType::c_type> &in_data,
+                    const WorkloadSpec &spec, const std::vector<SimdLevel> &levels, ResultsWriter &results) {
+    const std::string typeName = parquet::TypeToString(DType::type_num);
+    const RoundtripResult arrow = encoder_roundtrip<DType>(options, in_data, parquet::Encoding::DELTA_BINARY_PACKED);
+    auto report = [&](const std::string &codec, const RoundtripResult &result) {
+        // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+        const double encMbS = static_cast<double>(result.input_bytes)*1000/result.encode.median;
+        const double decMbS = static_cast<double>(result.input_bytes)*1000/result.decode.median;
+        const double encodeSpeedup = arrow.encode.median/result.encode.median;
+        const double decodeSpeedup = arrow.decode.median/result.decode.median;
+        std::cout << typeName << '\t' << workload_name(spec.kind) << '\t' << spec.delta << '\t' << codec << '\t'
+                    << result.encode_ns_per_value() << '\t' << result.decode_ns_per_value() << '\t' << encMbS
+                    << '\t' << decMbS << '\t' << encodeSpeedup << '\t' << decodeSpeedup << '\n';
+
+        ResultRecord record;
+        record.set("workload", workload_name(spec.kind)).set("delta", spec.delta).set("type", typeName)
+              .set("encoding", parquet::EncodingToString(parquet::Encoding::DELTA_BINARY_PACKED))
+              .set("codec", codec).set("encode_speedup", encodeSpeedup).set("decode_speedup", decodeSpeedup);
+        add_roundtrip_fields(record, result);
+        results.write(record);
+    };
+    report("arrow", arrow);
+    for(SimdLevel level : levels) {
+        report(std::string("reference-") + simd_level_name(level),
+               reference_delta_roundtrip(options, in_data.data(), static_cast<int64_t>(in_data.size()), level));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
+                    << " <Number of Values to write> [workload ... (default all)]\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count) || value_count < 1) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    std::vector<Workload> workloads;
+    try {
+        for(int i=2; i<argc; ++i) workloads.push_back(parse_workload(argv[i]));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    if(workloads.empty()) workloads.assign(allWorkloads.begin(), allWorkloads.end());
+    //_______________Parsing_done_______________
+    RoundtripOptions options;
+    options.warmup = 3;
+    options.sample_repeat = 20;
+    const std::vector<SimdLevel> levels = supported_simd_levels();
+
+    std::cout << "Time stamp counter runs at " << tsc_ticks_per_ns() << "GHz, cycles are counted in its ticks\n"
+                << "Reference codec up to " << simd_level_name(detect_simd_level()) << ", speedups relative to Arrow\n"
+                << "type\tworkload\tdelta\tcodec\tencode ns/value\tdecode ns/value\tencode MB/s\tdecode MB/s"
+                << "\tencode speedup\tdecode speedup\n";
+    try {
+        ResultsWriter results("DeltaCodecComparison", argc, argv);
+        for(Workload workload : workloads) {
+            for(int64_t delta : benchmarkDeltas) {
+                WorkloadSpec spec;
+                spec.kind = workload;
+                spec.delta = delta;
+                compare_codecs<parquet::Int32Type>(options, generate_workload<int32_t>(spec, value_count), spec,
+                                                   levels, results);
+                compare_codecs<parquet::Int64Type>(options, generate_workload<int64_t>(spec, value_count), spec,
+                                                   levels, results);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "parquet/encoding.h"
+#include "parquet/schema.h"
+#include "parquet/types.h"
+
+#include "BenchmarkClock.h"
+#include "DeltaBitPackCodec.h"
+#include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "RoundtripStatistics.h"
+#include "WorkloadGenerator.h"
+
+namespace {
+
+/**
+ * @brief Times of the measured scans in ns
+ */
+struct ScanTiming {
+    SampleStatistics scan;
+    //raw timings in the order they were taken
+    std::vector<double> samples;
+};
+
+/**
+ * @brief Runs scan() options.warmup times and then times it options.sample_repeat times
+ */
+template<typename ScanFn>
+ScanTiming measure(const RoundtripOptions &options, ScanFn scan) {
+    ScanTiming timing;
+    for(int s=0; s<options.warmup+options.sample_repeat; ++s) {
+        const Timestamp start = timestamp();
+        scan();
+        const Timestamp end = timestamp();
+        if(s >= options.warmup) timing.samples.push_back(static_cast<double>(end.ns-start.ns));
+    }
+    timing.scan = compute_statistics(timing.samples);
+    return timing;
+}
+
+/**
+ * @brief Measures range filters and aggregates over one DELTA_BINARY_PACKED page three ways: Arrow's
+ *        Decode followed by a pass over the values, the reference decoder followed by the same pass,
+ *        and the fused reference kernels that never materialize the values. Prints and writes one
+ *        record each, speedups are relative to the reference decoder followed by a pass
+ *
+ * @tparam DType parquet::Int32Type or parquet::Int64Type
+ * @param options The number of warm-up and measured repetitions
+ * @param in_data The values of the page
+ * @param spec The workload the data was generated with, written to the results
+ * @param selectivities The fractions of the values the range filters select
+ * @param results The results to write to
+ * @throw std::runtime_error if a scan does not return the result computed from the input
+ */
+template<typename DType>
+void compare_scans(const RoundtripOptions &options, const std::vector<typename DType::c_type> &in_data,
+                   const WorkloadSpec &spec, const std::vector<double> &selectivities, ResultsWriter &results) {
+    using T = typename DType::c_type;
+    const std::string typeName = parquet::TypeToString(DType::type_num);
+    const int64_t value_count = static_cast<int64_t>(in_data.size());
+    const SimdLevel level = detect_simd_level();
+    std::vector<uint8_t> page;
+    const int64_t pageSize = delta_encode(in_data.data(), value_count, page, level);
+
+    auto node = parquet::schema::PrimitiveNode::Make("Test", parquet::Repetition::REQUIRED, DType::type_num);
+    auto columnDescr = std::make_shared<parquet::ColumnDescriptor>(node, 0, 0);
+    auto decoder = parquet::MakeTypedDecoder<DType>(parquet::Encoding::DELTA_BINARY_PACKED, columnDescr.get());
+    std::vector<T> out_data(value_count);
+    auto arrowDecode = [&]() {
+        decoder->SetData(static_cast<int>(value_count), page.data(), static_cast<int>(pageSize));
+        decoder->Decode(out_data.data(), static_cast<int>(value_count));
+    };
+    auto referenceDecode = [&]() {
+        delta_decode(page.data(), pageSize, out_data.data(), value_count, level);
+    };
+
+    auto report = [&](const std::string &op, const std::string &strategy, double selectivity,
+                      const ScanTiming &timing, const ScanTiming &reference) {
+        const SampleStatistics &scan = timing.scan;
+        // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+        const double scanMbS = static_cast<double>(value_count*sizeof(T))*1000/scan.median;
+        const double speedup = reference.scan.median/scan.median;
+        std::cout << typeName << '\t' << workload_name(spec.kind) << '\t' << op << '\t' << selectivity << '\t'
+                    << strategy << '\t' << scan.median/value_count << '\t' << scanMbS << '\t' << speedup << '\n';
+
+        ResultRecord record;
+        record.set("workload", workload_name(spec.kind)).set("delta", spec.delta).set("type", typeName)
+              .set("encoding", parquet::EncodingToString(parquet::Encoding::DELTA_BINARY_PACKED))
+              .set("operator", op).set("strategy", strategy).set("selectivity", selectivity)
+              .set("value_count", value_count).set("encoded_bytes", pageSize)
+              .set("scan_ns_per_value", scan.median/value_count).set("scan_mbs", scanMbS)
+              .set("scan_ns", scan).set("scan_samples_ns", timing.samples).set("speedup", speedup);
+        results.write(record);
+    };
+
+    //______________range_filters______________
+    std::vector<T> sorted(in_data);
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<uint8_t> selection((value_count+7)/8);
+    std::vector<uint8_t> expected((value_count+7)/8);
+    for(double selectivity : selectivities) {
+        //a range around the median holding the fraction of the values, more with duplicates
+        const int64_t width = std::max<int64_t>(static_cast<int64_t>(selectivity*value_count), 1);
+        const int64_t first = std::min((value_count-width)/2, value_count-1);
+        const T lo = sorted.at(first);
+        const T hi = sorted.at(std::min(first+width-1, value_count-1));
+        const int64_t expectedCount = select_range(in_data.data(), value_count, lo, hi, expected.data());
+        int64_t selected{0};
+        auto check = [&](const std::string &strategy) {
+            if(selected != expectedCount || selection != expected) {
+                throw std::runtime_error(strategy + " filter of " + typeName + " " + workload_name(spec.kind)
+                                         + " selected the wrong values");
+            }
+        };
+
+        const ScanTiming arrow = measure(options, [&]() {
+            arrowDecode();
+            selected = select_range(out_data.data(), value_count, lo, hi, selection.data());
+        });
+        check("Arrow decode-then-filter");
+        const ScanTiming twoPass = measure(options, [&]() {
+            referenceDecode();
+            selected = select_range(out_data.data(), value_count, lo, hi, selection.data());
+        });
+        check("Decode-then-filter");
+        const ScanTiming fused = measure(options, [&]() {
+            selected = delta_decode_filter(page.data(), pageSize, lo, hi, selection.data(), value_count, level);
+        });
+        check("Fused");
+        const double actual = static_cast<double>(expectedCount)/value_count;
+        report("filter", "arrow-decode-then-filter", actual, arrow, twoPass);
+        report("filter", "decode-then-filter", actual, twoPass, twoPass);
+        report("filter", "fused-filter", actual, fused, twoPass);
+    }
+
+    //_______________aggregates_______________
+    const DeltaAggregate<T> expectedAggregate = aggregate_values(in_data.data(), value_count);
+    DeltaAggregate<T> aggregate;
+    auto checkAggregate = [&](const std::string &strategy) {
+        if(!(aggregate == expectedAggregate)) {
+            throw std::runtime_error(strategy + " aggregate of " + typeName + " " + workload_name(spec.kind)
+                                     + " is wrong");
+        }
+    };
+    const ScanTiming arrow = measure(options, [&]() {
+        arrowDecode();
+        aggregate = aggregate_values(out_data.data(), value_count);
+    });
+    checkAggregate("Arrow decode-then-aggregate");
+    const ScanTiming twoPass = measure(options, [&]() {
+        referenceDecode();
+        aggregate = aggregate_values(out_data.data(), value_count);
+    });
+    checkAggregate("Decode-then-aggregate");
+    const ScanTiming fused = measure(options, [&]() {
+        aggregate = delta_decode_aggregate<T>(page.data(), pageSize, level);
+    });
+    checkAggregate("Fused");
+    report("aggregate", "arrow-decode-then-aggregate", 1, arrow, twoPass);
+    report("aggregate", "decode-then-aggregate", 1, twoPass, twoPass);
+    report("aggregate", "fused-aggregate", 1, fused, twoPass);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
+                    << " <Number of Values to write> [workload ... (default all)]\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count) || value_count < 1) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    std::vector<Workload> workloads;
+    try {
+        for(int i=2; i<argc; ++i) workloads.push_back(parse_workload(argv[i]));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    if(workloads.empty()) workloads.assign(allWorkloads.begin(), allWorkloads.end());
+    //_______________Parsing_done_______________
+    RoundtripOptions options;
+    options.warmup = 3;
+    options.sample_repeat = 20;
+    const std::vector<double> selectivities{0.001, 0.01, 0.1, 0.5, 1.0};
+
+    std::cout << "Reference decoder at " << simd_level_name(detect_simd_level()) << ", speedups relative to"
+                << " decoding with it and scanning the decoded values\n"
+                << "type\tworkload\toperator\tselectivity\tstrategy\tns/value\tMB/s\tspeedup\n";
+    try {
+        ResultsWriter results("DeltaFusedScanThroughput", argc, argv);
+        for(Workload workload : workloads) {
+            for(int64_t delta : benchmarkDeltas) {
+                WorkloadSpec spec;
+                spec.kind = workload;
+                spec.delta = delta;
+                compare_scans<parquet::Int32Type>(options, generate_workload<int32_t>(spec, value_count), spec,
+                                                  selectivities, results);
+                compare_scans<parquet::Int64Type>(options, generate_workload<int64_t>(spec, value_count), spec,
+                                                  selectivities, results);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,124 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "parquet/types.h"
+
+#include "DeltaBitPackCodec.h"
+#include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+/**
+ * @brief Measures the decoding of one large DELTA_BINARY_PACKED page: Arrow's serial Decode, the
+ *        serial reference decoder and the parallel reference decoder on 1, 2, 4, ... threads up to
+ *        max_threads, and prints and writes one record each
+ *
+ * @tparam DType parquet::Int32Type or parquet::Int64Type
+ * @param options The number of warm-up and measured repetitions
+ * @param in_data The values of the page
+ * @param spec The workload the data was generated with, written to the results
+ * @param max_threads The largest thread count, always measured
+ * @param results The results to write to
+ */
+template<typename DType>
+void compare_decoders(const RoundtripOptions &options, const std::vector<typename DType::c_type> &in_data,
+                      const WorkloadSpec &spec, int max_threads, ResultsWriter &results) {
+    const std::string typeName = parquet::TypeToString(DType::type_num);
+    const RoundtripResult arrow = encoder_roundtrip<DType>(options, in_data, parquet::Encoding::DELTA_BINARY_PACKED);
+    const RoundtripResult serial = reference_delta_roundtrip(options, in_data.data(),
+                                                             static_cast<int64_t>(in_data.size()), detect_simd_level());
+    double singleThread{0};
+    auto report = [&](const std::string &decoder, int threads, const RoundtripResult &result) {
+        // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+        const double decMbS = static_cast<double>(result.input_bytes)*1000/result.decode.median;
+        const double arrowSpeedup = arrow.decode.median/result.decode.median;
+        const double serialSpeedup = serial.decode.median/result.decode.median;
+        //fraction of the linear speedup over the parallel decoder on one thread
+        const double efficiency = threads > 0 ? singleThread/(threads*result.decode.median) : 1;
+        std::cout << typeName << '\t' << workload_name(spec.kind) << '\t' << decoder << '\t' << threads << '\t'
+                    << result.decode_ns_per_value() << '\t' << decMbS << '\t' << arrowSpeedup << '\t'
+                    << serialSpeedup << '\t' << efficiency*100 << "%\n";
+
+        ResultRecord record;
+        record.set("workload", workload_name(spec.kind)).set("delta", spec.delta).set("type", typeName)
+              .set("encoding", parquet::EncodingToString(parquet::Encoding::DELTA_BINARY_PACKED))
+              .set("decoder", decoder).set("threads", threads).set("arrow_speedup", arrowSpeedup)
+              .set("serial_speedup", serialSpeedup).set("decode_efficiency", efficiency);
+        add_roundtrip_fields(record, result);
+        results.write(record);
+    };
+    report("arrow", 0, arrow);
+    report("reference-serial", 0, serial);
+    std::vector<int> threadCounts;
+    for(int threads=1; threads<max_threads; threads*=2) threadCounts.push_back(threads);
+    threadCounts.push_back(max_threads);
+    for(int threads : threadCounts) {
+        RoundtripOptions parallel = options;
+        parallel.decode_threads = threads;
+        const RoundtripResult result = encoder_roundtrip<DType>(parallel, in_data, parquet::Encoding::DELTA_BINARY_PACKED);
+        if(threads == 1) singleThread = result.decode.median;
+        report("reference-parallel", threads, result);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
+                    << " <Number of Values to write> [max thread count] [workload ... (default all)]\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count) || value_count < 1) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    int max_threads = static_cast<int>(std::thread::hardware_concurrency());
+    if(max_threads < 1) max_threads = 1;
+    if(argc > 2) {
+        std::istringstream s2(argv[2]);
+        if (!(s2 >> max_threads) || !s2.eof() || max_threads < 1) {
+            std::cerr << "Invalid thread count: " << argv[2] << '\n';
+            return 1;
+        }
+    }
+    std::vector<Workload> workloads;
+    try {
+        for(int i=3; i<argc; ++i) workloads.push_back(parse_workload(argv[i]));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    if(workloads.empty()) workloads.assign(allWorkloads.begin(), allWorkloads.end());
+    //_______________Parsing_done_______________
+    RoundtripOptions options;
+    options.warmup = 3;
+    options.sample_repeat = 20;
+
+    std::cout << "Reference decoder at " << simd_level_name(detect_simd_level()) << ", speedups relative to Arrow's"
+                << " Decode and the serial reference decoder, efficiency relative to the parallel decoder on one thread\n"
+                << "type\tworkload\tdecoder\tthreads\tdecode ns/value\tdecode MB/s\tarrow speedup\tserial speedup"
+                << "\tefficiency\n";
+    try {
+        ResultsWriter results("DeltaParallelDecodeThroughput", argc, argv);
+        for(Workload workload : workloads) {
+            WorkloadSpec spec;
+            spec.kind = workload;
+            compare_decoders<parquet::Int32Type>(options, generate_workload<int32_t>(spec, value_count), spec,
+                                                 max_threads, results);
+            compare_decoders<parquet::Int64Type>(options, generate_workload<int64_t>(spec, value_count), spec,
+                                                 max_threads, results);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <utility>
+#include <memory>
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+
+#include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+int main(int argc, char *argv[]) {
+    if(argc < 2 || argc > 4) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
+                    << " <Number of Values> [delta (default 1000)] [null fraction (default 0)]\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    int64_t delta{1000};
+    double null_fraction{0};
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count) || value_count < 1) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    if(argc > 2) {
+        std::istringstream s2(argv[2]);
+        if (!(s2 >> delta) || !s2.eof() || delta < 0) {
+            std::cerr << "Invalid delta: " << argv[2] << '\n';
+            return 1;
+        }
+    }
+    if(argc > 3) {
+        std::istringstream s3(argv[3]);
+        if (!(s3 >> null_fraction) || !s3.eof() || null_fraction < 0 || null_fraction >= 1) {
+            std::cerr << "Invalid null fraction: " << argv[3] << '\n';
+            return 1;
+        }
+    }
+    //_______________Parsing_done_______________
+    WorkloadSpec spec;
+    spec.delta = delta;
+    std::vector<int64_t> in_data = generate_workload<int64_t>(spec, value_count);
+    NullSpec nulls;
+    nulls.null_fraction = null_fraction;
+    int64_t null_count{0};
+    std::vector<uint8_t> valid_bits = generate_validity(nulls, value_count, &null_count);
+    //the array wraps the vectors without copying them, as a writer holding Arrow data would
+    arrow::Int64Array array(value_count, arrow::Buffer::Wrap(in_data),
+                            null_count > 0 ? arrow::Buffer::Wrap(valid_bits) : nullptr, null_count);
+    const int64_t nonNull = value_count-null_count;
+
+    RoundtripOptions options;
+    options.warmup = 3;
+    options.sample_repeat = 20;
+
+    ResultsWriter results("EncoderArrowThroughput", argc, argv);
+    for(auto encoding : {parquet::Encoding::DELTA_BINARY_PACKED, parquet::Encoding::PLAIN}) {
+        const std::string encodingName = parquet::EncodingToString(encoding);
+        RoundtripResult raw;
+        RoundtripResult viaArrow;
+        try {
+            raw = null_count > 0
+                ? encoder_spaced_roundtrip<parquet::Int64Type>(options, in_data.data(), value_count,
+                                                               valid_bits.data(), encoding)
+                : encoder_roundtrip<parquet::Int64Type>(options, in_data, encoding);
+            viaArrow = encoder_arrow_roundtrip(options, array, encoding);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+        const double rawEncodeNs = raw.encode.median/nonNull;
+        const double rawDecodeNs = raw.decode.median/nonNull;
+        const double arrowEncodeNs = viaArrow.encode.median/nonNull;
+        const double arrowDecodeNs = viaArrow.decode.median/nonNull;
+
+        std::cout << value_count << " values with delta of " << delta << ", " << encodingName << ", "
+                    << null_count << " nulls"
+                    << "\nPut(Array)\t" << arrowEncodeNs << "ns/value vs " << (null_count > 0 ? "PutSpaced " : "Put ")
+                    << rawEncodeNs << "ns/value (" << arrowEncodeNs/rawEncodeNs << "x)\t[" << viaArrow.encode << "]\n"
+                    << "DecodeArrow\t" << arrowDecodeNs << "ns/value vs "
+                    << (null_count > 0 ? "DecodeSpaced " : "Decode ") << rawDecodeNs << "ns/value ("
+                    << arrowDecodeNs/rawDecodeNs << "x)\t[" << viaArrow.decode << "]\n";
+        print_memory_usage(std::cout, viaArrow);
+
+        for(const auto &run : {std::make_pair("arrow", &viaArrow), std::make_pair("raw", &raw)}) {
+            ResultRecord record;
+            record.set("workload", workload_name(spec.kind)).set("delta", delta).set("type", "INT64")
+                  .set("encoding", encodingName).set("path", run.first).set("null_count", null_count)
+                  .set("encode_ns_per_non_null", run.second->encode.median/nonNull)
+                  .set("decode_ns_per_non_null", run.second->decode.median/nonNull);
+            add_roundtrip_fields(record, *run.second);
+            results.write(record);
+        }
+    }
+}
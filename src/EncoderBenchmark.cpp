@@ -0,0 +1,386 @@
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "parquet/types.h"
+
+#include "BenchmarkClock.h"
+#include "BenchmarkEnvironment.h"
+#include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+namespace {
+
+/**
+ * @brief The cross product of these lists is measured, every combination once
+ */
+struct BenchmarkMatrix {
+    std::vector<parquet::Type::type> types{parquet::Type::INT64};
+    std::vector<parquet::Encoding::type> encodings{parquet::Encoding::DELTA_BINARY_PACKED};
+    std::vector<Workload> workloads{Workload::ConstantDelta};
+    std::vector<int64_t> deltas{benchmarkDeltas.begin(), benchmarkDeltas.end()};
+    std::vector<int64_t> sizes{1'000'000};
+    //number of threads running the same roundtrips at the same time
+    std::vector<int> threads{1};
+    int repeat{100};
+    int warmup{5};
+    //cpus the benchmark threads are pinned to, thread t runs on cpus[t % size], empty to not pin
+    std::vector<int> cpus;
+    //NUMA node of the input and of everything the benchmark allocates, -1 to leave placement to the kernel
+    int numa_node{-1};
+    //touch every page of the input before measuring
+    bool prefault{false};
+    //name of the result files
+    std::string name{"EncoderBenchmark"};
+};
+
+const char usage[] =
+    " [--config <file>] [--types INT64,...] [--encodings DELTA_BINARY_PACKED,...]\n"
+    "        [--workloads constant,...] [--deltas 1,1000,...] [--sizes 1000000,...] [--threads 1,...]\n"
+    "        [--repeat 100] [--warmup 5] [--name EncoderBenchmark] [--cpus 0-3,8] [--numa-node 0] [--prefault 1]\n"
+    "Lists are separated by commas, settings given later override earlier ones. A config file holds one\n"
+    "'key = value' per line with the same keys, '#' starts a comment.\n"
+    "Types: INT32, INT64, FLOAT, DOUBLE, BYTE_ARRAY (the workload as floating point or decimal strings)\n"
+    "Workloads: constant, uniform, zipf, gaussian, timestamps, ids, spikes, mixed\n"
+    "Deltas default to the usual benchmark deltas, encodings a type does not support are skipped\n";
+
+std::vector<std::string> split_list(const std::string &list) {
+    std::vector<std::string> items;
+    std::istringstream stream(list);
+    std::string item;
+    while(std::getline(stream, item, ',')) {
+        const size_t start = item.find_first_not_of(" \t");
+        if(start == std::string::npos) continue;
+        items.push_back(item.substr(start, item.find_last_not_of(" \t")-start+1));
+    }
+    if(items.empty()) throw std::invalid_argument("Empty list: " + list);
+    return items;
+}
+
+template<typename T>
+T parse_number(const std::string &text, T min) {
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    std::istringstream stream(text);
+    T value;
+    if (!(stream >> value) || !stream.eof() || value < min) throw std::invalid_argument("Invalid number: " + text);
+    return value;
+}
+
+parquet::Type::type parse_type(const std::string &name) {
+    for(auto type : {parquet::Type::INT32, parquet::Type::INT64, parquet::Type::FLOAT,
+                     parquet::Type::DOUBLE, parquet::Type::BYTE_ARRAY}) {
+        if(name == parquet::TypeToString(type)) return type;
+    }
+    throw std::invalid_argument("Unknown or unsupported type: " + name);
+}
+
+void read_config(const std::string &path, BenchmarkMatrix &matrix);
+
+/**
+ * @brief Applies one setting to the matrix
+ *
+ * @throw std::invalid_argument for unknown keys or invalid values
+ */
+void apply_setting(const std::string &key, const std::string &value, BenchmarkMatrix &matrix) {
+    if(key == "config") {
+        read_config(value, matrix);
+    } else if(key == "types") {
+        matrix.types.clear();
+        for(const auto &item : split_list(value)) matrix.types.push_back(parse_type(item));
+    } else if(key == "encodings") {
+        matrix.encodings.clear();
+        for(const auto &item : split_list(value)) matrix.encodings.push_back(parse_encoding(item));
+    } else if(key == "workloads") {
+        matrix.workloads.clear();
+        for(const auto &item : split_list(value)) matrix.workloads.push_back(parse_workload(item));
+    } else if(key == "deltas") {
+        matrix.deltas.clear();
+        for(const auto &item : split_list(value)) matrix.deltas.push_back(parse_number<int64_t>(item, 0));
+    } else if(key == "sizes") {
+        matrix.sizes.clear();
+        for(const auto &item : split_list(value)) matrix.sizes.push_back(parse_number<int64_t>(item, 1));
+    } else if(key == "threads") {
+        matrix.threads.clear();
+        for(const auto &item : split_list(value)) matrix.threads.push_back(parse_number<int>(item, 1));
+    } else if(key == "repeat") {
+        matrix.repeat = parse_number<int>(value, 1);
+    } else if(key == "warmup") {
+        matrix.warmup = parse_number<int>(value, 0);
+    } else if(key == "name") {
+        if(value.empty() || value.find('/') != std::string::npos) throw std::invalid_argument("Invalid name: " + value);
+        matrix.name = value;
+    } else if(key == "cpus") {
+        matrix.cpus = parse_cpu_list(value);
+    } else if(key == "numa-node") {
+        matrix.numa_node = parse_number<int>(value, 0);
+        if(matrix.numa_node >= numa_node_count()) throw std::invalid_argument("No NUMA node " + value);
+    } else if(key == "prefault") {
+        matrix.prefault = parse_number<int>(value, 0) != 0;
+    } else {
+        throw std::invalid_argument("Unknown setting: " + key);
+    }
+}
+
+/**
+ * @throw std::invalid_argument if the file cannot be read or holds an invalid setting
+ */
+void read_config(const std::string &path, BenchmarkMatrix &matrix) {
+    std::ifstream file(path);
+    if(!file) throw std::invalid_argument("Cannot open config file " + path);
+    std::string line;
+    for(int lineNumber=1; std::getline(file, line); ++lineNumber) {
+        line = line.substr(0, line.find('#'));
+        if(line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        const size_t equals = line.find('=');
+        if(equals == std::string::npos) {
+            throw std::invalid_argument(path + ':' + std::to_string(lineNumber) + ": expected key = value");
+        }
+        auto trim = [](const std::string &text) {
+            const size_t start = text.find_first_not_of(" \t\r");
+            return start == std::string::npos ? std::string() : text.substr(start, text.find_last_not_of(" \t\r")-start+1);
+        };
+        try {
+            apply_setting(trim(line.substr(0, equals)), trim(line.substr(equals+1)), matrix);
+        } catch (const std::invalid_argument &e) {
+            throw std::invalid_argument(path + ':' + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+}
+
+/**
+ * @brief One generated sequence in every physical type: as generated for INT32 and INT64, as
+ *        floating point and as decimal strings
+ */
+struct ColumnData {
+    std::vector<int32_t> int32_values;
+    std::vector<int64_t> int64_values;
+    std::vector<float> float_values;
+    std::vector<double> double_values;
+    //the byte arrays point into the strings
+    std::vector<std::string> strings;
+    std::vector<parquet::ByteArray> byte_array_values;
+
+    ColumnData(const WorkloadSpec &spec, int64_t value_count, const std::vector<parquet::Type::type> &types) {
+        auto wanted = [&types](parquet::Type::type type) {
+            for(auto t : types) if(t == type) return true;
+            return false;
+        };
+        if(wanted(parquet::Type::INT32)) int32_values = generate_workload<int32_t>(spec, value_count);
+        if(!wanted(parquet::Type::INT64) && !wanted(parquet::Type::FLOAT) && !wanted(parquet::Type::DOUBLE)
+           && !wanted(parquet::Type::BYTE_ARRAY)) return;
+        int64_values = generate_workload<int64_t>(spec, value_count);
+        if(wanted(parquet::Type::FLOAT)) float_values.assign(int64_values.begin(), int64_values.end());
+        if(wanted(parquet::Type::DOUBLE)) double_values.assign(int64_values.begin(), int64_values.end());
+        if(wanted(parquet::Type::BYTE_ARRAY)) {
+            strings.reserve(int64_values.size());
+            for(auto elem : int64_values) strings.push_back(std::to_string(elem));
+            byte_array_values.reserve(strings.size());
+            for(const auto &str : strings) {
+                byte_array_values.emplace_back(static_cast<uint32_t>(str.size()),
+                                               reinterpret_cast<const uint8_t *>(str.data()));
+            }
+        }
+    }
+
+    //a copy of the strings would leave the byte arrays pointing into the original
+    ColumnData(const ColumnData &) = delete;
+    ColumnData &operator=(const ColumnData &) = delete;
+
+    /**
+     * @brief Moves the values to a NUMA node unless it is negative and touches all their pages if
+     *        prefault is set. The characters of strings too long for the small string buffer stay
+     *        where they are
+     */
+    void place(int numa_node, bool prefault_pages) {
+        auto placeVector = [&](auto &values) {
+            if(values.empty()) return;
+            const size_t bytes = values.size()*sizeof(values.front());
+            if(numa_node >= 0) move_to_node(values.data(), bytes, numa_node);
+            if(prefault_pages) prefault(values.data(), bytes);
+        };
+        placeVector(int32_values);
+        placeVector(int64_values);
+        placeVector(float_values);
+        placeVector(double_values);
+        placeVector(strings);
+        placeVector(byte_array_values);
+    }
+
+    template<typename DType>
+    const std::vector<typename DType::c_type> &values() const {
+        if constexpr (std::is_same<DType, parquet::Int32Type>::value) return int32_values;
+        else if constexpr (std::is_same<DType, parquet::Int64Type>::value) return int64_values;
+        else if constexpr (std::is_same<DType, parquet::FloatType>::value) return float_values;
+        else if constexpr (std::is_same<DType, parquet::DoubleType>::value) return double_values;
+        else return byte_array_values;
+    }
+};
+
+/**
+ * @brief Runs the roundtrips on thread_count threads at the same time, every thread on the same
+ *        input, and returns the result of every thread. Thread t is pinned to cpus[t % size] unless
+ *        cpus is empty, a single thread runs on the calling thread
+ */
+template<typename DType>
+std::vector<RoundtripResult> concurrent_roundtrips(const RoundtripOptions &options,
+                                                   const std::vector<typename DType::c_type> &in_data,
+                                                   parquet::Encoding::type encoding, int thread_count,
+                                                   const std::vector<int> &cpus) {
+    std::vector<RoundtripResult> results(thread_count);
+    if(thread_count == 1) {
+        results.front() = encoder_roundtrip<DType>(options, in_data, encoding);
+        return results;
+    }
+    std::vector<std::exception_ptr> errors(thread_count);
+    std::vector<std::thread> workers;
+    for(int t=0; t<thread_count; ++t) {
+        workers.emplace_back([&, t]() {
+            try {
+                if(!cpus.empty()) pin_current_thread({cpus.at(t % cpus.size())});
+                results.at(t) = encoder_roundtrip<DType>(options, in_data, encoding);
+            } catch (...) {
+                errors.at(t) = std::current_exception();
+            }
+        });
+    }
+    for(auto &worker : workers) worker.join();
+    for(const auto &error : errors) {
+        if(error) std::rethrow_exception(error);
+    }
+    return results;
+}
+
+/**
+ * @brief Measures every encoding and thread count of the matrix for one type and writes a record each
+ *
+ * @return int the number of combinations that were skipped because the type does not support the encoding
+ */
+template<typename DType>
+int run_type(const BenchmarkMatrix &matrix, const ColumnData &data, const WorkloadSpec &spec,
+             ResultsWriter &results) {
+    const std::string typeName = parquet::TypeToString(DType::type_num);
+    std::string cpusName;
+    for(int cpu : matrix.cpus) cpusName += (cpusName.empty() ? "" : ",") + std::to_string(cpu);
+    RoundtripOptions options;
+    options.sample_repeat = matrix.repeat;
+    options.warmup = matrix.warmup;
+    int skipped{0};
+    for(auto encoding : matrix.encodings) {
+        if(!encoding_supported(DType::type_num, encoding)) {
+            skipped += static_cast<int>(matrix.threads.size());
+            continue;
+        }
+        const std::string encodingName = parquet::EncodingToString(encoding);
+        for(int threads : matrix.threads) {
+            const std::vector<RoundtripResult> perThread =
+                concurrent_roundtrips<DType>(options, data.values<DType>(), encoding, threads, matrix.cpus);
+            //the slowest thread bounds the aggregate throughput
+            double slowestEncode{0};
+            double slowestDecode{0};
+            for(const auto &result : perThread) {
+                slowestEncode = std::max(slowestEncode, result.encode.median);
+                slowestDecode = std::max(slowestDecode, result.decode.median);
+            }
+            const RoundtripResult &result = perThread.front();
+            // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+            const double aggregateEncMbS = static_cast<double>(result.input_bytes)*threads*1000/slowestEncode;
+            const double aggregateDecMbS = static_cast<double>(result.input_bytes)*threads*1000/slowestDecode;
+
+            std::cout << typeName << '\t' << encodingName << '\t' << workload_name(spec.kind) << '\t' << spec.delta
+                        << '\t' << result.value_count << '\t' << threads << '\t' << result.encode_ns_per_value()
+                        << '\t' << result.decode_ns_per_value() << '\t' << aggregateEncMbS << '\t' << aggregateDecMbS
+                        << '\t' << result.compression_ratio() << '\n';
+
+            ResultRecord record;
+            record.set("workload", workload_name(spec.kind)).set("delta", spec.delta).set("type", typeName)
+                  .set("encoding", encodingName).set("threads", threads)
+                  .set("cpus", cpusName).set("numa_node", matrix.numa_node)
+                  .set("aggregate_encode_mbs", aggregateEncMbS).set("aggregate_decode_mbs", aggregateDecMbS);
+            //the statistics are those of the first thread
+            add_roundtrip_fields(record, result);
+            results.write(record);
+        }
+    }
+    return skipped;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    //______________Parsing_arguments___________
+    BenchmarkMatrix matrix;
+    try {
+        for(int a=1; a<argc; ++a) {
+            std::string arg = argv[a];
+            if(arg == "--help" || arg == "-h") {
+                std::cout << "Usage: " << argv[0] << usage;
+                return 0;
+            }
+            if(arg.compare(0, 2, "--") != 0) throw std::invalid_argument("Unexpected argument: " + arg);
+            arg = arg.substr(2);
+            const size_t equals = arg.find('=');
+            if(equals != std::string::npos) {
+                apply_setting(arg.substr(0, equals), arg.substr(equals+1), matrix);
+            } else if(a+1 < argc) {
+                apply_setting(arg, argv[++a], matrix);
+            } else {
+                throw std::invalid_argument("Missing value for --" + arg);
+            }
+        }
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\nUsage: " << argv[0] << usage;
+        return 1;
+    }
+    //_______________Parsing_done_______________
+    const size_t combinations = matrix.types.size()*matrix.encodings.size()*matrix.workloads.size()
+                                *matrix.deltas.size()*matrix.sizes.size()*matrix.threads.size();
+    std::cout << "Measuring up to " << combinations << " combinations with " << matrix.repeat << " samples each\n"
+                << "Time stamp counter runs at " << tsc_ticks_per_ns() << "GHz, cycles are counted in its ticks\n"
+                << "type\tencoding\tworkload\tdelta\tvalues\tthreads\tencode ns/value\tdecode ns/value"
+                << "\tencode MB/s\tdecode MB/s\tratio\n";
+    int skipped{0};
+    try {
+        //workers inherit the affinity and memory policy of the main thread, they pin themselves further
+        if(!matrix.cpus.empty()) pin_current_thread({matrix.cpus.front()});
+        if(matrix.numa_node >= 0) bind_thread_memory(matrix.numa_node);
+        for(const auto &warning : measurement_noise_warnings(matrix.cpus)) std::cerr << "Warning: " << warning << '\n';
+        ResultsWriter results(matrix.name, argc, argv);
+        for(int64_t size : matrix.sizes) {
+            for(Workload workload : matrix.workloads) {
+                for(int64_t delta : matrix.deltas) {
+                    WorkloadSpec spec;
+                    spec.kind = workload;
+                    spec.delta = delta;
+                    ColumnData data(spec, size, matrix.types);
+                    //the generator threads may have touched the pages first on other nodes
+                    data.place(matrix.numa_node, matrix.prefault);
+                    for(auto type : matrix.types) {
+                        switch(type) {
+                            case parquet::Type::INT32:
+                                skipped += run_type<parquet::Int32Type>(matrix, data, spec, results); break;
+                            case parquet::Type::INT64:
+                                skipped += run_type<parquet::Int64Type>(matrix, data, spec, results); break;
+                            case parquet::Type::FLOAT:
+                                skipped += run_type<parquet::FloatType>(matrix, data, spec, results); break;
+                            case parquet::Type::DOUBLE:
+                                skipped += run_type<parquet::DoubleType>(matrix, data, spec, results); break;
+                            default:
+                                skipped += run_type<parquet::ByteArrayType>(matrix, data, spec, results); break;
+                        }
+                    }
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    if(skipped > 0) std::cout << skipped << " combinations skipped, the type does not support the encoding\n";
+}
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "parquet/types.h"
+
+#include "EncoderParallelRoundtripTest.h"
+#include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+/**
+ * @brief Measures the encoding of one column into a single page by one encoder and into one page
+ *        per thread by parallel_chunked_encode on 1, 2, 4, ... threads up to max_threads, and prints
+ *        and writes one record each
+ *
+ * @tparam DType parquet::Int32Type or parquet::Int64Type
+ * @param options The number of warm-up and measured repetitions
+ * @param in_data The values of the column
+ * @param spec The workload the data was generated with, written to the results
+ * @param max_threads The largest thread count, always measured
+ * @param results The results to write to
+ */
+template<typename DType>
+void compare_encoders(const RoundtripOptions &options, const std::vector<typename DType::c_type> &in_data,
+                      const WorkloadSpec &spec, int max_threads, ResultsWriter &results) {
+    const std::string typeName = parquet::TypeToString(DType::type_num);
+    const int64_t value_count = static_cast<int64_t>(in_data.size());
+    const RoundtripResult serial = encoder_roundtrip<DType>(options, in_data, parquet::Encoding::DELTA_BINARY_PACKED);
+    double singleThread{0};
+    auto report = [&](const std::string &mode, int threads, int pages, int64_t encoded_bytes,
+                      const SampleStatistics &encode, const std::vector<double> &samples) {
+        // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+        const double encMbS = static_cast<double>(serial.input_bytes)*1000/encode.median;
+        const double speedup = serial.encode.median/encode.median;
+        //fraction of the linear speedup over the chunked encode on one thread
+        const double efficiency = singleThread > 0 ? singleThread/(threads*encode.median) : 1;
+        std::cout << typeName << '\t' << workload_name(spec.kind) << '\t' << mode << '\t' << threads << '\t'
+                    << pages << '\t' << encode.median/value_count << '\t' << encMbS << '\t' << speedup << '\t'
+                    << efficiency*100 << "%\t" << encoded_bytes << '\n';
+
+        ResultRecord record;
+        record.set("workload", workload_name(spec.kind)).set("delta", spec.delta).set("type", typeName)
+              .set("encoding", parquet::EncodingToString(parquet::Encoding::DELTA_BINARY_PACKED))
+              .set("mode", mode).set("threads", threads).set("pages", pages).set("value_count", value_count)
+              .set("input_bytes", serial.input_bytes).set("encoded_bytes", encoded_bytes).set("encode_mbs", encMbS)
+              .set("encode_ns_per_value", encode.median/value_count).set("encode_ns", encode)
+              .set("encode_samples_ns", samples).set("encode_speedup", speedup).set("encode_efficiency", efficiency);
+        results.write(record);
+    };
+    report("serial", 1, 1, serial.encoded_bytes, serial.encode, serial.encode_samples);
+
+    std::vector<int> threadCounts;
+    for(int threads=1; threads<max_threads; threads*=2) threadCounts.push_back(threads);
+    threadCounts.push_back(max_threads);
+    for(int threads : threadCounts) {
+        const ChunkedEncodeResult result = chunked_encode_roundtrip<DType>(options, in_data, threads);
+        if(threads == 1) singleThread = result.encode_wall.median;
+        report("chunked", threads, result.page_count, result.encoded_bytes, result.encode_wall,
+               result.encode_samples);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
+                    << " <Number of Values to write> [max thread count] [workload ... (default timestamps)]\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count) || value_count < 1) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    int max_threads = static_cast<int>(std::thread::hardware_concurrency());
+    if(max_threads < 1) max_threads = 1;
+    if(argc > 2) {
+        std::istringstream s2(argv[2]);
+        if (!(s2 >> max_threads) || !s2.eof() || max_threads < 1) {
+            std::cerr << "Invalid thread count: " << argv[2] << '\n';
+            return 1;
+        }
+    }
+    std::vector<Workload> workloads;
+    try {
+        for(int i=3; i<argc; ++i) workloads.push_back(parse_workload(argv[i]));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    if(workloads.empty()) workloads = {Workload::Timestamps};
+    //_______________Parsing_done_______________
+    RoundtripOptions options;
+    options.warmup = 3;
+    options.sample_repeat = 20;
+
+    std::cout << "Speedups relative to one encoder writing a single page, efficiency relative to the chunked"
+                << " encode on one thread\n"
+                << "type\tworkload\tmode\tthreads\tpages\tencode ns/value\tencode MB/s\tspeedup\tefficiency"
+                << "\tencoded bytes\n";
+    try {
+        ResultsWriter results("EncoderChunkedThroughput", argc, argv);
+        for(Workload workload : workloads) {
+            WorkloadSpec spec;
+            spec.kind = workload;
+            compare_encoders<parquet::Int32Type>(options, generate_workload<int32_t>(spec, value_count), spec,
+                                                 max_threads, results);
+            compare_encoders<parquet::Int64Type>(options, generate_workload<int64_t>(spec, value_count), spec,
+                                                 max_threads, results);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "arrow/io/file.h"
+#include "parquet/api/reader.h"
+#include "parquet/api/writer.h"
+
+#include "BenchmarkClock.h"
+#include "EncoderFileRoundtripTest.h"
+
+namespace {
+
+//values requested per ReadBatch call
+constexpr int64_t readBatchSize{1 << 20};
+
+std::shared_ptr<parquet::schema::GroupNode> file_schema() {
+    parquet::schema::NodeVector fields;
+    fields.push_back(parquet::schema::PrimitiveNode::Make("value", parquet::Repetition::REQUIRED,
+                                                          parquet::Type::INT64));
+    return std::static_pointer_cast<parquet::schema::GroupNode>(
+        parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
+}
+
+/**
+ * @brief Writes the file row group by row group
+ *
+ * @return int64_t the size of the written file in bytes
+ */
+int64_t write_file(const int64_t *in_data, int64_t value_count, const FileLayout &layout,
+                   const std::shared_ptr<parquet::WriterProperties> &properties, const std::string &path) {
+    std::shared_ptr<arrow::io::FileOutputStream> outfile;
+    PARQUET_ASSIGN_OR_THROW(outfile, arrow::io::FileOutputStream::Open(path));
+    std::unique_ptr<parquet::ParquetFileWriter> writer =
+        parquet::ParquetFileWriter::Open(outfile, file_schema(), properties);
+    for(int64_t offset=0; offset<value_count; offset+=layout.row_group_size) {
+        const int64_t rows = std::min(layout.row_group_size, value_count-offset);
+        parquet::RowGroupWriter *rowGroup = writer->AppendRowGroup();
+        auto *column = static_cast<parquet::Int64Writer *>(rowGroup->NextColumn());
+        column->WriteBatch(rows, nullptr, nullptr, in_data+offset);
+        rowGroup->Close();
+    }
+    writer->Close();
+    int64_t file_bytes{0};
+    PARQUET_ASSIGN_OR_THROW(file_bytes, outfile->Tell());
+    PARQUET_THROW_NOT_OK(outfile->Close());
+    return file_bytes;
+}
+
+/**
+ * @brief Reads all values of the file into out_data, which has to be large enough
+ *
+ * @return int the number of row groups
+ */
+int read_file(const std::string &path, std::vector<int64_t> &out_data) {
+    std::unique_ptr<parquet::ParquetFileReader> reader = parquet::ParquetFileReader::OpenFile(path, false);
+    const int row_groups = reader->metadata()->num_row_groups();
+    int64_t offset{0};
+    for(int r=0; r<row_groups; ++r) {
+        std::shared_ptr<parquet::ColumnReader> columnReader = reader->RowGroup(r)->Column(0);
+        auto *column = static_cast<parquet::Int64Reader *>(columnReader.get());
+        while(column->HasNext()) {
+            int64_t values_read{0};
+            const int64_t batch = std::min<int64_t>(readBatchSize, static_cast<int64_t>(out_data.size())-offset);
+            if(batch <= 0) throw std::runtime_error("File holds more values than were written");
+            column->ReadBatch(batch, nullptr, nullptr, out_data.data()+offset, &values_read);
+            offset += values_read;
+        }
+    }
+    if(offset != static_cast<int64_t>(out_data.size())) {
+        throw std::runtime_error("Read " + std::to_string(offset) + " values but expected "
+                                 + std::to_string(out_data.size()));
+    }
+    return row_groups;
+}
+
+/**
+ * @brief Encodings of the data pages of all row groups in the order they first occur
+ */
+std::vector<parquet::Encoding::type> data_page_encodings(const std::string &path) {
+    std::unique_ptr<parquet::ParquetFileReader> reader = parquet::ParquetFileReader::OpenFile(path, false);
+    std::vector<parquet::Encoding::type> encodings;
+    for(int r=0; r<reader->metadata()->num_row_groups(); ++r) {
+        //the statistics live in the column chunk metadata, which has to outlive the loop
+        const std::unique_ptr<parquet::ColumnChunkMetaData> column = reader->metadata()->RowGroup(r)->ColumnChunk(0);
+        for(const auto &stats : column->encoding_stats()) {
+            if(stats.page_type == parquet::PageType::DICTIONARY_PAGE) continue;
+            if(std::find(encodings.begin(), encodings.end(), stats.encoding) == encodings.end()) {
+                encodings.push_back(stats.encoding);
+            }
+        }
+    }
+    return encodings;
+}
+
+/**
+ * @brief Removes the file when it goes out of scope, also if the roundtrip throws
+ */
+struct RemoveOnExit {
+    const std::string &path;
+    ~RemoveOnExit() { std::remove(path.c_str()); }
+};
+
+} // namespace
+
+FileRoundtripResult file_roundtrip(const RoundtripOptions &options, const int64_t *in_data, int64_t value_count,
+                                   const FileLayout &layout, const std::string &path) {
+    parquet::WriterProperties::Builder builder;
+    builder.compression(layout.codec)
+           ->data_pagesize(layout.page_size)
+           ->max_row_group_length(layout.row_group_size)
+           ->encoding(parquet::Encoding::DELTA_BINARY_PACKED);
+    if(layout.dictionary) builder.enable_dictionary();
+    else builder.disable_dictionary();
+    std::shared_ptr<parquet::WriterProperties> properties = builder.build();
+
+    FileRoundtripResult result{};
+    result.input_bytes = value_count*static_cast<int64_t>(sizeof(int64_t));
+    std::vector<double> write_samples;
+    std::vector<double> read_samples;
+    std::vector<int64_t> out_data(value_count);
+    const RemoveOnExit removeFile{path};
+    for(int i=0; i<options.warmup+options.sample_repeat; ++i) {
+        const Timestamp writeStart = timestamp();
+        result.file_bytes = write_file(in_data, value_count, layout, properties, path);
+        const Timestamp writeEnd = timestamp();
+        result.row_groups = read_file(path, out_data);
+        const Timestamp readEnd = timestamp();
+        //validate data
+        if(!std::equal(out_data.begin(), out_data.end(), in_data)) {
+            throw std::runtime_error("File roundtrip did not reproduce the values");
+        }
+        if(i < options.warmup) continue;
+        write_samples.push_back(static_cast<double>(writeEnd.ns-writeStart.ns));
+        read_samples.push_back(static_cast<double>(readEnd.ns-writeEnd.ns));
+        if(options.adaptive && static_cast<int>(write_samples.size()) >= options.min_samples &&
+           compute_statistics(write_samples).relative_ci() <= options.ci_target &&
+           compute_statistics(read_samples).relative_ci() <= options.ci_target) {
+            break;
+        }
+    }
+    //read outside of the timed roundtrips, the pages are the same in all of them
+    result.data_page_encodings = data_page_encodings(path);
+    result.write = compute_statistics(write_samples);
+    result.read = compute_statistics(read_samples);
+    return result;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "arrow/util/compression.h"
+#include "parquet/types.h"
+
+#include "EncoderRoundtripTest.h"
+#include "RoundtripStatistics.h"
+
+/**
+ * @brief Writer settings of a file roundtrip
+ */
+struct FileLayout {
+    //maximum number of rows per row group
+    int64_t row_group_size{1024*1024};
+    //target size of a data page in bytes
+    int64_t page_size{1024*1024};
+    //dictionary encode the column. Arrow applies DELTA_BINARY_PACKED only without dictionary, a
+    //dictionary that grows too large falls back to PLAIN
+    bool dictionary{false};
+    arrow::Compression::type codec{arrow::Compression::UNCOMPRESSED};
+};
+
+/**
+ * @brief Measurements of a file roundtrip, all times in ns
+ */
+struct FileRoundtripResult {
+    //from opening the output file until it is closed
+    SampleStatistics write;
+    //from opening the file until all values are read
+    SampleStatistics read;
+    int64_t input_bytes;
+    int64_t file_bytes;
+    int row_groups;
+    //encodings of the data pages in the order they first occur, e.g. RLE_DICTIONARY followed by
+    //PLAIN once the dictionary fell back
+    std::vector<parquet::Encoding::type> data_page_encodings;
+};
+
+/**
+ * @brief Writes the values as a single required INT64 column to a Parquet file through
+ *        parquet::ParquetFileWriter with DELTA_BINARY_PACKED encoding, or dictionary encoding if
+ *        layout.dictionary is set, which Arrow falls back from to PLAIN, reads them back through
+ *        parquet::ParquetFileReader and validates them. Page headers, statistics, compression and
+ *        column chunk I/O are included in the timings. The file is read right after it was written,
+ *        so it is usually served from the page cache; it is removed afterwards
+ *
+ * @param options The number of warm-up and measured repetitions
+ * @param in_data The int64_t data to write
+ * @param value_count The number of values
+ * @param layout Row group size, page size, dictionary and compression codec
+ * @param path Path of the file to write
+ * @return FileRoundtripResult write and read time statistics in ns, the file size and the encodings
+ *         the data pages were actually written with
+ * @throw parquet::ParquetException if the file cannot be written or read,
+ *        std::runtime_error if a roundtrip did not reproduce the values
+ */
+FileRoundtripResult file_roundtrip(const RoundtripOptions &options, const int64_t *in_data, int64_t value_count,
+                                   const FileLayout &layout, const std::string &path);
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <array>
+#include "arrow/util/compression.h"
+
+#include "EncoderFileRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+int main(int argc, char *argv[]) {
+    if(argc < 2 || argc > 4) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
+                    << " <Number of Values to write> [delta (default 1000)] [output directory (default .)]\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    int64_t delta{1000};
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count) || value_count < 1) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    if(argc > 2) {
+        std::istringstream s2(argv[2]);
+        if (!(s2 >> delta) || !s2.eof() || delta < 0) {
+            std::cerr << "Invalid delta: " << argv[2] << '\n';
+            return 1;
+        }
+    }
+    const std::string path = std::string(argc > 3 ? argv[3] : ".") + "/EncoderFileThroughput.parquet";
+    //_______________Parsing_done_______________
+    const std::array<int64_t, 3> rowGroupSizes{{64*1024, 1024*1024, 8*1024*1024}};
+    const std::array<int64_t, 3> pageSizes{{64*1024, 1024*1024, 8*1024*1024}};
+    const std::array<arrow::Compression::type, 4> codecs{{arrow::Compression::UNCOMPRESSED,
+                                                          arrow::Compression::SNAPPY, arrow::Compression::ZSTD,
+                                                          arrow::Compression::LZ4}};
+
+    WorkloadSpec spec;
+    spec.delta = delta;
+    std::vector<int64_t> in_data = generate_workload<int64_t>(spec, value_count);
+    const float bytes = static_cast<float>(value_count*sizeof(int64_t));
+
+    RoundtripOptions options;
+    options.warmup = 1;
+    options.sample_repeat = 10;
+
+    ResultsWriter results("EncoderFileThroughput", argc, argv);
+    for(auto codec : codecs) {
+        const std::string codecName = arrow::util::Codec::GetCodecAsString(codec);
+        if(!arrow::util::Codec::IsAvailable(codec)) {
+            std::cout << codecName << " is not available in this Arrow build, skipped\n";
+            continue;
+        }
+        for(bool dictionary : {false, true}) {
+            for(int64_t rowGroupSize : rowGroupSizes) {
+                //row groups larger than the input all give the same file
+                if(rowGroupSize > value_count && rowGroupSize != rowGroupSizes.front()) continue;
+                for(int64_t pageSize : pageSizes) {
+                    FileLayout layout;
+                    layout.row_group_size = rowGroupSize;
+                    layout.page_size = pageSize;
+                    layout.dictionary = dictionary;
+                    layout.codec = codec;
+                    FileRoundtripResult result;
+                    try {
+                        result = file_roundtrip(options, in_data.data(), value_count, layout, path);
+                    } catch (const std::exception& e) {
+                        std::cerr << e.what() << '\n';
+                        return 1;
+                    }
+                    //a dictionary column is never DELTA_BINARY_PACKED, name what was actually written
+                    std::string encodingName;
+                    for(parquet::Encoding::type encoding : result.data_page_encodings) {
+                        encodingName += (encodingName.empty() ? "" : "+") + parquet::EncodingToString(encoding);
+                    }
+                    // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+                    float writeMbS = bytes*1000/result.write.median;
+                    float readMbS = bytes*1000/result.read.median;
+
+                    std::cout << value_count << " values (" << bytes/1'000'000 << "Mb) with delta of " << delta
+                                << ", " << encodingName << ", " << codecName << (dictionary ? ", dictionary" : "")
+                                << ", row groups of " << rowGroupSize << " rows (" << result.row_groups
+                                << "), pages of " << pageSize << " bytes"
+                                << "\nWriting took\t" << result.write.median << "ns → ~" << writeMbS
+                                << "Mb/s\t[" << result.write << "]\n"
+                                << "Reading took\t" << result.read.median << "ns → ~" << readMbS
+                                << "Mb/s\t[" << result.read << "]\n"
+                                << "File size\t" << result.file_bytes << " bytes (ratio "
+                                << static_cast<double>(result.input_bytes)/result.file_bytes << ")\n";
+
+                    ResultRecord record;
+                    record.set("workload", workload_name(spec.kind)).set("delta", delta).set("type", "INT64")
+                          .set("encoding", encodingName).set("codec", codecName)
+                          .set("dictionary", dictionary).set("row_group_size", rowGroupSize)
+                          .set("page_size", pageSize).set("value_count", value_count)
+                          .set("input_bytes", result.input_bytes).set("file_bytes", result.file_bytes)
+                          .set("row_groups", result.row_groups).set("write_mbs", writeMbS).set("read_mbs", readMbS)
+                          .set("write_ns", result.write).set("read_ns", result.read);
+                    results.write(record);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,249 @@
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include "arrow/buffer.h"
+#include "parquet/schema.h"
+#include "parquet/encoding.h"
+#include "parquet/types.h"
+
+#include "BenchmarkClock.h"
+#include "DeltaBitPackCodec.h"
+#include "EncoderParallelRoundtripTest.h"
+
+namespace {
+
+/**
+ * @brief Reusable barrier to let all worker threads start a phase at the same time
+ */
+class PhaseBarrier {
+public:
+    explicit PhaseBarrier(int thread_count) : thread_count(thread_count), waiting(0), generation(0) {}
+
+    void arrive_and_wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        int arrived_generation = generation;
+        if(++waiting == thread_count) {
+            waiting = 0;
+            ++generation;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [&]{ return generation != arrived_generation; });
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    const int thread_count;
+    int waiting;
+    int generation;
+};
+
+/**
+ * @brief Timestamps of one thread in one sample
+ */
+struct PhaseTimes {
+    Timestamp startE, mid, startD, endD;
+    bool valid{false};
+};
+
+/**
+ * @brief Worker loop of one thread: encodes and decodes [begin, begin+count) once per sample
+ */
+void roundtrip_worker(const int64_t *begin, int64_t count, PhaseBarrier &barrier, std::vector<PhaseTimes> &times) {
+    for(size_t s=0; s<times.size(); ++s) {
+        auto node = parquet::schema::Int64("Test", parquet::Repetition::REQUIRED);
+        auto columnDescr = std::make_shared<parquet::ColumnDescriptor>(node, 0, 0);
+
+        auto encoder =
+            parquet::MakeTypedEncoder<parquet::Int64Type>(parquet::Encoding::DELTA_BINARY_PACKED, false, columnDescr.get());
+        auto decoder = parquet::MakeTypedDecoder<parquet::Int64Type>(parquet::Encoding::DELTA_BINARY_PACKED, columnDescr.get());
+
+        std::vector<int64_t> out_data;
+        out_data.resize(count);
+        PhaseTimes &t = times.at(s);
+        //wait for all threads before encoding
+        barrier.arrive_and_wait();
+        t.startE = timestamp();
+        encoder->Put(begin, static_cast<int>(count));
+        auto encode_buffer = encoder->FlushValues();
+        t.mid = timestamp();
+        //wait for all threads before decoding so encode and decode phases do not overlap
+        barrier.arrive_and_wait();
+        t.startD = timestamp();
+        decoder->SetData(static_cast<int>(count), encode_buffer->data(),
+                            static_cast<int>(encode_buffer->size()));
+        int values_decoded = decoder->Decode(out_data.data(), static_cast<int>(count));
+        t.endD = timestamp();
+        //validate data
+        t.valid = values_decoded == count && std::equal(out_data.begin(), out_data.end(), begin);
+        //wait for all threads before the next sample starts allocating
+        barrier.arrive_and_wait();
+    }
+}
+
+} // namespace
+
+ParallelRoundtripResult parallel_encoder_roundtrip(const RoundtripOptions &options, std::vector<int64_t> &in_data,
+                                                   int thread_count, ParallelMode mode) {
+    if(thread_count < 1) {
+        throw std::invalid_argument("thread_count must be at least 1");
+    }
+    const int64_t value_count = static_cast<int64_t>(in_data.size());
+    const int samples = options.warmup+options.sample_repeat;
+    std::vector<std::vector<PhaseTimes>> times(thread_count, std::vector<PhaseTimes>(samples));
+    PhaseBarrier barrier(thread_count);
+
+    ParallelRoundtripResult result{};
+    result.thread_count = thread_count;
+    std::vector<std::thread> workers;
+    for(int t=0; t<thread_count; ++t) {
+        const int64_t *begin = in_data.data();
+        int64_t count = value_count;
+        if(mode == ParallelMode::Shard) {
+            //spread the remainder over the first threads
+            int64_t share = value_count / thread_count;
+            int64_t remainder = value_count % thread_count;
+            begin += t*share + std::min<int64_t>(t, remainder);
+            count = share + (t < remainder ? 1 : 0);
+        }
+        result.total_bytes += count*static_cast<int64_t>(sizeof(int64_t));
+        result.per_thread.push_back({count*static_cast<int64_t>(sizeof(int64_t)), {}, {}});
+        workers.emplace_back(roundtrip_worker, begin, count, std::ref(barrier), std::ref(times.at(t)));
+    }
+    for(auto &worker : workers) worker.join();
+
+    //statistics of the measured samples every thread validated
+    for(int t=0; t<thread_count; ++t) {
+        std::vector<double> encodeSamples;
+        std::vector<double> decodeSamples;
+        for(int s=options.warmup; s<samples; ++s) {
+            const PhaseTimes &sample = times.at(t).at(s);
+            if(!sample.valid) continue;
+            encodeSamples.push_back(static_cast<double>(sample.mid.ns-sample.startE.ns));
+            decodeSamples.push_back(static_cast<double>(sample.endD.ns-sample.startD.ns));
+        }
+        if(encodeSamples.empty()) std::cerr << "Validation unsuccessful for every sample of thread " << t << "!\n";
+        result.per_thread.at(t).encode = compute_statistics(encodeSamples);
+        result.per_thread.at(t).decode = compute_statistics(decodeSamples);
+    }
+
+    //wall times of the measured samples in which every thread validated successfully
+    std::vector<double> encodeWall;
+    std::vector<double> decodeWall;
+    for(int s=options.warmup; s<samples; ++s) {
+        bool all_valid = true;
+        int64_t startE = std::numeric_limits<int64_t>::max(), mid = std::numeric_limits<int64_t>::min();
+        int64_t startD = std::numeric_limits<int64_t>::max(), endD = std::numeric_limits<int64_t>::min();
+        for(int t=0; t<thread_count; ++t) {
+            const PhaseTimes &sample = times.at(t).at(s);
+            all_valid = all_valid && sample.valid;
+            startE = std::min(startE, sample.startE.ns);
+            mid = std::max(mid, sample.mid.ns);
+            startD = std::min(startD, sample.startD.ns);
+            endD = std::max(endD, sample.endD.ns);
+        }
+        if(!all_valid) {
+            std::cerr << "Validation complete. Unsuccessful in sample " << s << "!\n";
+            continue;
+        }
+        encodeWall.push_back(static_cast<double>(mid-startE));
+        decodeWall.push_back(static_cast<double>(endD-startD));
+    }
+    if(encodeWall.empty()) {
+        throw std::runtime_error("No sample of the parallel roundtrip validated successfully");
+    }
+    result.encode_wall = compute_statistics(encodeWall);
+    result.decode_wall = compute_statistics(decodeWall);
+    return result;
+}
+
+template<typename DType>
+std::vector<std::shared_ptr<arrow::Buffer>> parallel_chunked_encode(const typename DType::c_type *in_data,
+                                                                    int64_t value_count, int thread_count) {
+    if(thread_count < 1) {
+        throw std::invalid_argument("thread_count must be at least 1");
+    }
+    constexpr int64_t blockSize{deltaBlockSize<typename DType::c_type>};
+    const int64_t blocks = std::max<int64_t>((value_count+blockSize-1)/blockSize, 1);
+    const int pages = static_cast<int>(std::min<int64_t>(thread_count, blocks));
+    //page p holds the blocks [p*blocks/pages, (p+1)*blocks/pages)
+    auto chunkBegin = [&](int p) { return std::min(p*blocks/pages*blockSize, value_count); };
+    std::vector<std::shared_ptr<arrow::Buffer>> result(pages);
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    auto worker = [&](int p) {
+        try {
+            auto node = parquet::schema::PrimitiveNode::Make("Test", parquet::Repetition::REQUIRED, DType::type_num);
+            auto columnDescr = std::make_shared<parquet::ColumnDescriptor>(node, 0, 0);
+            auto encoder = parquet::MakeTypedEncoder<DType>(parquet::Encoding::DELTA_BINARY_PACKED, false,
+                                                            columnDescr.get());
+            encoder->Put(in_data+chunkBegin(p), static_cast<int>(chunkBegin(p+1)-chunkBegin(p)));
+            result.at(p) = encoder->FlushValues();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if(!error) error = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    for(int p=1; p<pages; ++p) workers.emplace_back(worker, p);
+    worker(0);
+    for(auto &thread : workers) thread.join();
+    if(error) std::rethrow_exception(error);
+    return result;
+}
+
+template<typename DType>
+ChunkedEncodeResult chunked_encode_roundtrip(const RoundtripOptions &options,
+                                             const std::vector<typename DType::c_type> &in_data, int thread_count) {
+    using T = typename DType::c_type;
+    const int64_t value_count = static_cast<int64_t>(in_data.size());
+    ChunkedEncodeResult result{};
+    result.thread_count = thread_count;
+    result.value_count = value_count;
+    result.input_bytes = value_count*static_cast<int64_t>(sizeof(T));
+    for(int s=0; s<options.warmup+options.sample_repeat; ++s) {
+        const Timestamp start = timestamp();
+        std::vector<std::shared_ptr<arrow::Buffer>> pages = parallel_chunked_encode<DType>(in_data.data(), value_count,
+                                                                                         thread_count);
+        const Timestamp end = timestamp();
+        if(s >= options.warmup) result.encode_samples.push_back(static_cast<double>(end.ns-start.ns));
+        if(s > 0) continue;
+        //validate the pages of the first sample, the others are the same
+        result.page_count = static_cast<int>(pages.size());
+        auto node = parquet::schema::PrimitiveNode::Make("Test", parquet::Repetition::REQUIRED, DType::type_num);
+        auto columnDescr = std::make_shared<parquet::ColumnDescriptor>(node, 0, 0);
+        auto decoder = parquet::MakeTypedDecoder<DType>(parquet::Encoding::DELTA_BINARY_PACKED, columnDescr.get());
+        std::vector<T> out_data(value_count);
+        int64_t decoded{0};
+        for(const auto &page : pages) {
+            const int64_t pageValues = parse_delta_header(page->data(), page->size()).value_count;
+            if(decoded+pageValues > value_count) break;
+            decoder->SetData(static_cast<int>(pageValues), page->data(), static_cast<int>(page->size()));
+            decoded += decoder->Decode(out_data.data()+decoded, static_cast<int>(pageValues));
+            result.encoded_bytes += page->size();
+        }
+        if(decoded != value_count || !std::equal(out_data.begin(), out_data.end(), in_data.begin())) {
+            throw std::runtime_error("The pages of the chunked encode do not decode to the input");
+        }
+    }
+    result.encode_wall = compute_statistics(result.encode_samples);
+    return result;
+}
+
+template std::vector<std::shared_ptr<arrow::Buffer>> parallel_chunked_encode<parquet::Int32Type>(
+    const int32_t *, int64_t, int);
+template std::vector<std::shared_ptr<arrow::Buffer>> parallel_chunked_encode<parquet::Int64Type>(
+    const int64_t *, int64_t, int);
+template ChunkedEncodeResult chunked_encode_roundtrip<parquet::Int32Type>(const RoundtripOptions &,
+                                                                          const std::vector<int32_t> &, int);
+template ChunkedEncodeResult chunked_encode_roundtrip<parquet::Int64Type>(const RoundtripOptions &,
+                                                                          const std::vector<int64_t> &, int);
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/type_fwd.h"
+#include "parquet/types.h"
+
+#include "EncoderRoundtripTest.h"
+#include "RoundtripStatistics.h"
+
+/**
+ * @brief How the input of a multi-threaded roundtrip is distributed across the worker threads
+ */
+enum class ParallelMode {
+    Shard,  ///< every thread encodes and decodes its own contiguous slice of the input
+    Columns ///< every thread encodes and decodes the whole input as if it was an independent column
+};
+
+/**
+ * @brief Measurements of one worker thread of a multi-threaded roundtrip, all times in ns
+ */
+struct ThreadRoundtripResult {
+    //number of bytes the thread encodes (and decodes) in one sample
+    int64_t input_bytes;
+    //statistics of the samples the thread validated, count is 0 if it validated none
+    SampleStatistics encode;
+    SampleStatistics decode;
+};
+
+/**
+ * @brief Measurements of a multi-threaded roundtrip, all times in ns
+ */
+struct ParallelRoundtripResult {
+    int thread_count;
+    //number of bytes encoded (and decoded) across all threads in one sample
+    int64_t total_bytes;
+    std::vector<ThreadRoundtripResult> per_thread;
+    //wall time from the common start until the last thread finished encoding, of the samples in
+    //which every thread validated
+    SampleStatistics encode_wall;
+    //wall time from the common start until the last thread finished decoding
+    SampleStatistics decode_wall;
+};
+
+/**
+ * @brief Runs DELTA_BINARY_PACKED encoder roundtrips on thread_count threads at the same time.
+ *        All threads start each encode and each decode phase together, so the wall times
+ *        reflect the aggregate throughput of the machine
+ *
+ * @param options The number of warm-up and measured repetitions
+ * @param in_data The int64_t data to use for the roundtrip
+ * @param thread_count The number of worker threads
+ * @param mode Whether the input is split between the threads or encoded by every thread
+ * @return ParallelRoundtripResult per-thread and wall time statistics in ns
+ * @throw std::runtime_error if no measured sample validated on every thread
+ */
+ParallelRoundtripResult parallel_encoder_roundtrip(const RoundtripOptions &options, std::vector<int64_t> &in_data,
+                                                   int thread_count, ParallelMode mode);
+
+/**
+ * @brief Measurements of a column encoded into several pages at once, all times in ns
+ */
+struct ChunkedEncodeResult {
+    int thread_count;
+    //number of pages the column was split into, at most one per thread
+    int page_count;
+    int64_t value_count;
+    //size of the unencoded column and the sum of the page sizes in bytes
+    int64_t input_bytes;
+    int64_t encoded_bytes;
+    //wall time from starting the workers until the last page was flushed
+    SampleStatistics encode_wall;
+    //raw wall times of the measured samples in the order they were taken
+    std::vector<double> encode_samples;
+
+    double encode_ns_per_value() const { return encode_wall.median/value_count; }
+};
+
+/**
+ * @brief Encodes a column into DELTA_BINARY_PACKED pages on thread_count threads at the same time.
+ *        The column is split into contiguous chunks of whole blocks (128 INT32 or 256 INT64 values,
+ *        the last chunk may end in a partial block), and every chunk is encoded by its own
+ *        encoder into its own page. The threads are started per call
+ *
+ * @tparam DType parquet::Int32Type or parquet::Int64Type
+ * @param in_data The values of the column
+ * @param value_count The number of values in in_data
+ * @param thread_count The number of threads and chunks, at most one per block
+ * @return the pages in column order
+ * @throw std::invalid_argument if thread_count is less than 1
+ */
+template<typename DType>
+std::vector<std::shared_ptr<arrow::Buffer>> parallel_chunked_encode(const typename DType::c_type *in_data,
+                                                                    int64_t value_count, int thread_count);
+
+/**
+ * @brief Measures the wall time of parallel_chunked_encode. The pages of the first sample are
+ *        decoded and compared to the input outside the measurement
+ *
+ * @param options The number of warm-up and measured repetitions, the other options are ignored
+ * @throw std::runtime_error if the pages do not decode to the input
+ */
+template<typename DType>
+ChunkedEncodeResult chunked_encode_roundtrip(const RoundtripOptions &options,
+                                             const std::vector<typename DType::c_type> &in_data, int thread_count);
+
+extern template std::vector<std::shared_ptr<arrow::Buffer>> parallel_chunked_encode<parquet::Int32Type>(
+    const int32_t *, int64_t, int);
+extern template std::vector<std::shared_ptr<arrow::Buffer>> parallel_chunked_encode<parquet::Int64Type>(
+    const int64_t *, int64_t, int);
+extern template ChunkedEncodeResult chunked_encode_roundtrip<parquet::Int32Type>(const RoundtripOptions &,
+                                                                                 const std::vector<int32_t> &, int);
+extern template ChunkedEncodeResult chunked_encode_roundtrip<parquet::Int64Type>(const RoundtripOptions &,
+                                                                                 const std::vector<int64_t> &, int);
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <array>
+#include <limits>
+#include <thread>
+
+#include "EncoderParallelRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+int main(int argc, char *argv[]) {
+    if(argc < 2 || argc > 4) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
+                    << " <Number of Values to write> [shard|columns] [max thread count]\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count)) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    ParallelMode mode = ParallelMode::Shard;
+    if(argc > 2) {
+        std::string modeArg(argv[2]);
+        if(modeArg == "columns") {
+            mode = ParallelMode::Columns;
+        } else if(modeArg != "shard") {
+            std::cerr << "Invalid mode: " << argv[2] << " (expected shard or columns)\n";
+            return 1;
+        }
+    }
+    int max_threads = static_cast<int>(std::thread::hardware_concurrency());
+    if(max_threads < 1) max_threads = 1;
+    if(argc > 3) {
+        std::istringstream s3(argv[3]);
+        if (!(s3 >> max_threads) || !s3.eof() || max_threads < 1) {
+            std::cerr << "Invalid thread count: " << argv[3] << '\n';
+            return 1;
+        }
+    }
+    const char *modeName = mode == ParallelMode::Shard ? "shard" : "columns";
+    //_______________Parsing_done_______________
+    RoundtripOptions options;
+    options.sample_repeat = 100;
+
+    ResultsWriter results("EncoderParallelThroughput", argc, argv);
+    for(int64_t delta : benchmarkDeltas) {
+        //fill some_data with evenly spaced values
+        WorkloadSpec spec;
+        spec.delta = delta;
+        std::vector<int64_t> in_data = generate_workload<int64_t>(spec, value_count);
+
+        //aggregate throughput of a single thread as reference for the scaling efficiency
+        float singleEncMbS{0};
+        float singleDecMbS{0};
+        for(int threads=1; threads<=max_threads; ++threads) {
+            ParallelRoundtripResult result = parallel_encoder_roundtrip(options, in_data, threads, mode);
+
+            // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+            float encMbS = static_cast<float>(result.total_bytes)*1000/result.encode_wall.median;
+            float decMbS = static_cast<float>(result.total_bytes)*1000/result.decode_wall.median;
+            if(threads == 1) {
+                singleEncMbS = encMbS;
+                singleDecMbS = decMbS;
+            }
+            //fraction of the linear speedup that was reached
+            float encEfficiency = encMbS/(threads*singleEncMbS);
+            float decEfficiency = decMbS/(threads*singleDecMbS);
+
+            std::cout << value_count << " values (" << static_cast<float>(result.total_bytes)/1'000'000
+                        << "Mb in total) with delta of " << delta << " on " << threads << " thread(s), mode " << modeName
+                        << "\nEncoding took\t" << result.encode_wall.median << "ns → ~" << encMbS << "Mb/s"
+                        << " (efficiency " << encEfficiency*100 << "%)\t[" << result.encode_wall << "]\n"
+                        << "Decoding took\t" << result.decode_wall.median << "ns → ~" << decMbS << "Mb/s"
+                        << " (efficiency " << decEfficiency*100 << "%)\t[" << result.decode_wall << "]\n";
+            for(int t=0; t<result.thread_count; ++t) {
+                const ThreadRoundtripResult &thread = result.per_thread.at(t);
+                //no timings to divide by, the failure was reported by the roundtrip
+                if(thread.encode.count == 0) continue;
+                const float threadBytes = static_cast<float>(thread.input_bytes);
+                std::cout << "\tthread " << t << ": encoding " << thread.encode.median << "ns → ~"
+                            << threadBytes*1000/thread.encode.median << "Mb/s, decoding " << thread.decode.median
+                            << "ns → ~" << threadBytes*1000/thread.decode.median << "Mb/s\n";
+            }
+
+            ResultRecord record;
+            record.set("workload", workload_name(spec.kind)).set("delta", delta).set("type", "INT64")
+                  .set("encoding", "DELTA_BINARY_PACKED").set("mode", modeName).set("threads", threads)
+                  .set("value_count", value_count).set("total_bytes", result.total_bytes)
+                  .set("encode_wall_ns", result.encode_wall).set("decode_wall_ns", result.decode_wall)
+                  .set("encode_mbs", encMbS).set("decode_mbs", decMbS)
+                  .set("encode_efficiency", encEfficiency).set("decode_efficiency", decEfficiency);
+            results.write(record);
+        }
+    }
+}
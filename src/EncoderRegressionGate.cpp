@@ -0,0 +1,236 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "parquet/types.h"
+
+#include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "RoundtripStatistics.h"
+#include "WorkloadGenerator.h"
+
+namespace {
+
+/**
+ * @brief Generates the workload of the record and measures it with the same number of samples
+ *
+ * @throw std::invalid_argument if the record names an unknown workload, type or encoding
+ */
+RoundtripResult rerun(const ResultRecord &baseline, int sample_repeat) {
+    WorkloadSpec spec;
+    spec.kind = parse_workload(baseline.text("workload"));
+    spec.delta = static_cast<int64_t>(baseline.number("delta"));
+    const int64_t value_count = static_cast<int64_t>(baseline.number("value_count"));
+    const std::string &type = baseline.text("type");
+    const parquet::Encoding::type encoding = parse_encoding(baseline.text("encoding"));
+
+    RoundtripOptions options;
+    options.sample_repeat = sample_repeat;
+    if(type == "INT32") {
+        return encoder_roundtrip<parquet::Int32Type>(options, generate_workload<int32_t>(spec, value_count), encoding);
+    }
+    if(type == "INT64") {
+        return encoder_roundtrip<parquet::Int64Type>(options, generate_workload<int64_t>(spec, value_count), encoding);
+    }
+    throw std::invalid_argument("Unsupported type: " + type);
+}
+
+//marks the records of record_baseline: encoder_roundtrip with default RoundtripOptions of
+//generate_workload data of the record's type and a default WorkloadSpec apart from the delta
+constexpr const char *replayField{"default_roundtrip"};
+
+/**
+ * @brief Whether the record was written by record_baseline and can be measured again by rerun.
+ *        Other drivers measure threads, pinned CPUs, reused codecs, other decoders or converted
+ *        data under the same field names, so their records are never compared
+ */
+bool comparable(const ResultRecord &record) {
+    for(const char *name : {replayField, "workload", "delta", "type", "encoding", "value_count",
+                            "encode_samples_ns", "decode_samples_ns"}) {
+        if(record.find(name) == nullptr) return false;
+    }
+    return record.text(replayField) == "true" && !record.numbers("encode_samples_ns").empty();
+}
+
+struct Verdict {
+    //throughput of the current run relative to the baseline minus 1, negative if it got slower
+    double change;
+    double p;
+    bool regression;
+};
+
+Verdict judge(const std::vector<double> &baseline, const std::vector<double> &current,
+              double threshold, double alpha) {
+    const double baseMedian = compute_statistics(baseline).median;
+    const double currentMedian = compute_statistics(current).median;
+    Verdict verdict;
+    verdict.change = baseMedian/currentMedian - 1;
+    verdict.p = mann_whitney_greater_p(current, baseline);
+    //both significant and large enough to matter
+    verdict.regression = verdict.p < alpha && -verdict.change > threshold;
+    return verdict;
+}
+
+int record_baseline(int argc, char *argv[]) {
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    std::istringstream s1(argv[2]);
+    if (!(s1 >> value_count) || value_count < 1) {
+        std::cerr << "Invalid number: " << argv[2] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[2] << '\n';
+        return 1;
+    }
+    //_______________Parsing_done_______________
+    ResultsWriter results("EncoderRegressionGate", argc, argv);
+    for(Workload workload : {Workload::ConstantDelta, Workload::UniformDelta}) {
+        for(int64_t delta : benchmarkDeltas) {
+            WorkloadSpec spec;
+            spec.kind = workload;
+            spec.delta = delta;
+            for(const char *type : {"INT32", "INT64"}) {
+                RoundtripOptions options;
+                RoundtripResult result = type == std::string("INT32")
+                    ? encoder_roundtrip<parquet::Int32Type>(options, generate_workload<int32_t>(spec, value_count),
+                                                            parquet::Encoding::DELTA_BINARY_PACKED)
+                    : encoder_roundtrip<parquet::Int64Type>(options, generate_workload<int64_t>(spec, value_count),
+                                                            parquet::Encoding::DELTA_BINARY_PACKED);
+                std::cout << workload_name(workload) << " delta " << delta << ' ' << type
+                            << "\tencode " << result.encode_ns_per_value() << "ns/value\tdecode "
+                            << result.decode_ns_per_value() << "ns/value\n";
+
+                ResultRecord record;
+                record.set(replayField, true).set("workload", workload_name(workload)).set("delta", delta)
+                      .set("type", type).set("encoding", "DELTA_BINARY_PACKED");
+                add_roundtrip_fields(record, result);
+                results.write(record);
+            }
+        }
+    }
+    std::cout << "Baseline written to " << results.json_path() << '\n';
+    return 0;
+}
+
+int compare_baseline(int argc, char *argv[]) {
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    const std::string path = argv[2];
+    double threshold{0.05};
+    double alpha{0.01};
+    if(argc > 3) {
+        std::istringstream s3(argv[3]);
+        if (!(s3 >> threshold) || !s3.eof() || threshold < 0 || threshold >= 1) {
+            std::cerr << "Invalid threshold: " << argv[3] << '\n';
+            return 1;
+        }
+    }
+    if(argc > 4) {
+        std::istringstream s4(argv[4]);
+        if (!(s4 >> alpha) || !s4.eof() || alpha <= 0 || alpha >= 1) {
+            std::cerr << "Invalid significance level: " << argv[4] << '\n';
+            return 1;
+        }
+    }
+    //_______________Parsing_done_______________
+    std::vector<ResultRecord> baseline;
+    try {
+        baseline = read_results(path);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    ResultsWriter results("EncoderRegressionGate_compare", argc, argv);
+    int compared{0};
+    int skipped{0};
+    int regressions{0};
+    std::cout << "Regression if throughput drops by more than " << threshold*100 << "% at p < " << alpha << '\n'
+                << "workload\tdelta\ttype\tencoding\tencode change\tp\tdecode change\tp\n";
+    //one throwaway roundtrip, so the first configuration is not measured with cold caches and clocks
+    for(const ResultRecord &base : baseline) {
+        if(!comparable(base)) continue;
+        try {
+            rerun(base, static_cast<int>(base.numbers("encode_samples_ns").size()));
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+        break;
+    }
+    for(const ResultRecord &base : baseline) {
+        if(!comparable(base)) {
+            ++skipped;
+            continue;
+        }
+        const std::vector<double> baseEncode = base.numbers("encode_samples_ns");
+        const std::vector<double> baseDecode = base.numbers("decode_samples_ns");
+        RoundtripResult current;
+        try {
+            current = rerun(base, static_cast<int>(baseEncode.size()));
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+        Verdict encode = judge(baseEncode, current.encode_samples, threshold, alpha);
+        Verdict decode = judge(baseDecode, current.decode_samples, threshold, alpha);
+        //a single measurement regresses by noise alone now and then: measure a flagged configuration
+        //again and only count what regresses both times, reporting the second measurement
+        const bool remeasured = encode.regression || decode.regression;
+        if(remeasured) {
+            try {
+                current = rerun(base, static_cast<int>(baseEncode.size()));
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+                return 1;
+            }
+            const Verdict encodeAgain = judge(baseEncode, current.encode_samples, threshold, alpha);
+            const Verdict decodeAgain = judge(baseDecode, current.decode_samples, threshold, alpha);
+            encode = {encodeAgain.change, encodeAgain.p, encode.regression && encodeAgain.regression};
+            decode = {decodeAgain.change, decodeAgain.p, decode.regression && decodeAgain.regression};
+        }
+        ++compared;
+        regressions += encode.regression + decode.regression;
+
+        std::cout << base.text("workload") << '\t' << base.text("delta") << '\t' << base.text("type") << '\t'
+                    << base.text("encoding") << '\t' << encode.change*100 << '%' << (encode.regression ? " REGRESSION" : "")
+                    << '\t' << encode.p << '\t' << decode.change*100 << '%' << (decode.regression ? " REGRESSION" : "")
+                    << '\t' << decode.p << (remeasured ? "\tremeasured" : "") << '\n';
+
+        ResultRecord record;
+        record.set("workload", base.text("workload")).set("delta", static_cast<int64_t>(base.number("delta")))
+              .set("type", base.text("type")).set("encoding", base.text("encoding"))
+              .set("baseline_run_id", base.find("run_id") != nullptr ? base.text("run_id") : "")
+              .set("threshold", threshold).set("alpha", alpha).set("remeasured", remeasured)
+              .set("encode_throughput_change", encode.change).set("encode_p", encode.p)
+              .set("encode_regression", encode.regression)
+              .set("decode_throughput_change", decode.change).set("decode_p", decode.p)
+              .set("decode_regression", decode.regression);
+        add_roundtrip_fields(record, current);
+        results.write(record);
+    }
+    if(skipped > 0) {
+        std::cout << skipped << " records not written by " << argv[0] << " record were skipped\n";
+    }
+    if(compared == 0) {
+        std::cerr << "No comparable records in " << path << '\n';
+        return 1;
+    }
+    std::cout << compared << " configurations compared, " << regressions << " regressions\n";
+    return regressions > 0 ? 2 : 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const std::string mode = argc > 1 ? argv[1] : "";
+    if(mode == "record" && argc == 3) return record_baseline(argc, argv);
+    if(mode == "compare" && argc >= 3 && argc <= 5) return compare_baseline(argc, argv);
+    std::cerr << "Invalid Arguments! Usage: " << argv[0] << " record <Number of Values>\n"
+                << "       " << argv[0] << " compare <baseline .jsonl> [throughput drop threshold (default 0.05)]"
+                << " [significance level (default 0.01)]\n"
+                << "compare exits with 2 if encode or decode throughput regressed\n";
+    return 1;
+}
@@ -2,243 +2,659 @@
 #include <stdexcept>
 #include <string>
 #include <vector>
-#include <chrono>
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "arrow/util/config.h"
 #include "parquet/schema.h"
 #include "parquet/encoding.h"
+#include "parquet/platform.h"
 #include "parquet/types.h"
+#include "parquet/exception.h"
+#include "arrow/array.h"
+#include "arrow/builder.h"
 
+#include "BenchmarkClock.h"
+#include "DeltaBitPackCodec.h"
 #include "EncoderRoundtripTest.h"
+
+namespace {
+
 /**
- * @brief Executes a set amout of parquet-encoder(DELTA_BINARY_PACKED encoding) roundtrips with the given data
- *        and returns the best measurement pair (sorted by encoding time) in µs
- * 
- * @param sample_repeat the number of 
- * @param in_data An int64_t vector containing the data to be used for the round trips
- * @return std::pair<int64_t, int64_t> a pair of (encode time, decode time) in µs
+ * @brief Compares two values, floating point values bitwise so NaN and -0.0 roundtrip exactly
  */
-std::pair<int64_t, int64_t> encoder_roundtrip(int sample_repeat, std::vector<int64_t> &in_data) {
-    //test repeatedly and pick minimum result
-    std::vector<std::pair<int64_t, int64_t>> measurements;
-    for(int i=0; i<sample_repeat; ++i) {
-        //________________start_test________________
-        auto node = parquet::schema::Int64("Test", parquet::Repetition::REQUIRED);
-        auto columnDescr = std::make_shared<parquet::ColumnDescriptor>(node, 0, 0);
+template<typename T>
+bool same_value(const T &a, const T &b) { return a == b; }
+bool same_value(float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; }
+bool same_value(double a, double b) { return std::memcmp(&a, &b, sizeof(double)) == 0; }
 
-        auto encoder =
-            parquet::MakeTypedEncoder<parquet::Int64Type>(parquet::Encoding::DELTA_BINARY_PACKED, false, columnDescr.get());
-        auto decoder = parquet::MakeTypedDecoder<parquet::Int64Type>(parquet::Encoding::DELTA_BINARY_PACKED, columnDescr.get());
+/**
+ * @brief Returns the value in a form std::ostream can print
+ */
+template<typename T>
+const T &printable(const T &value) { return value; }
+std::string printable(const parquet::ByteArray &value) {
+    return std::string(reinterpret_cast<const char *>(value.ptr), value.len);
+}
 
-        std::vector<int64_t> out_data;
-        out_data.resize(in_data.size());
-        //start timing encoding
-        const auto startE = std::chrono::steady_clock::now();
-        //encode
-        encoder->Put(in_data.data(), in_data.size());
-        auto encode_buffer = encoder->FlushValues();
-        //stop timing encoding & start timeing decoding
-        const auto mid = std::chrono::steady_clock::now();
-        //decode
-        decoder->SetData(in_data.size(), encode_buffer->data(),
-                            static_cast<int>(encode_buffer->size()));
-        int values_decoded = decoder->Decode(out_data.data(), out_data.size());
-        //stop timing decoding
-        const auto endE = std::chrono::steady_clock::now();
-        //check output volume
-        if(values_decoded != in_data.size()) {
-            std::cerr << "Decoded " << values_decoded << " values but expected " << in_data.size() << " !\n";
-        }
-        //validate data
-        int error_count{0};
-        int err_output_limit{10};
-        for(int i = 0; i < in_data.size(); ++i) {
-            int64_t in{in_data.at(i)};
-            int64_t out{out_data.at(i)};
-            if(in != out) {
-                ++error_count;
-                if( err_output_limit < 0 || error_count <= err_output_limit)
-                std::cerr << "Mismatching value #" << i << "was expected to be "
-                            << in << " but was " << out << '\n';
-                if(error_count == err_output_limit) {
-                    std::cerr << "Too many mismatched values! Omitting output...\n";
-                }
+/**
+ * @brief Whether slot i holds a value, every slot does without a validity bitmap
+ */
+bool is_valid(const uint8_t *valid_bits, int64_t i) {
+    return valid_bits == nullptr || ((valid_bits[i >> 3] >> (i & 7)) & 1) != 0;
+}
+
+/**
+ * @brief Size of the unencoded non-null values in bytes, for byte arrays the sum of their lengths
+ */
+template<typename T>
+int64_t payload_bytes(const T *, int64_t value_count, const uint8_t *, int64_t null_count) {
+    return (value_count-null_count)*static_cast<int64_t>(sizeof(T));
+}
+int64_t payload_bytes(const parquet::ByteArray *values, int64_t value_count, const uint8_t *valid_bits, int64_t) {
+    int64_t bytes{0};
+    for(int64_t i=0; i<value_count; ++i) {
+        if(is_valid(valid_bits, i)) bytes += values[i].len;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Compares the decoded data to the input and reports the first mismatches, null slots are
+ *        not compared
+ *
+ * @return int the number of mismatched values
+ */
+template<typename T>
+int count_mismatches(const T *in_data, const std::vector<T> &out_data, const uint8_t *valid_bits) {
+    int error_count{0};
+    int err_output_limit{10};
+    for(size_t i = 0; i < out_data.size(); ++i) {
+        if(!is_valid(valid_bits, static_cast<int64_t>(i))) continue;
+        const T &in{in_data[i]};
+        const T &out{out_data.at(i)};
+        if(!same_value(in, out)) {
+            ++error_count;
+            if( err_output_limit < 0 || error_count <= err_output_limit)
+            std::cerr << "Mismatching value #" << i << "was expected to be "
+                        << printable(in) << " but was " << printable(out) << '\n';
+            if(error_count == err_output_limit) {
+                std::cerr << "Too many mismatched values! Omitting output...\n";
             }
         }
-        if(error_count == 0) {
-            //time encoding took in µs
-            auto encMicroS =
-            std::chrono::duration_cast<std::chrono::microseconds>(mid-startE).count();
-            //time decoding took in µs
-            auto decMicroS =
-            std::chrono::duration_cast<std::chrono::microseconds>(endE-mid).count();
-            //add this runs measurements to the list
-            measurements.push_back(std::make_pair(encMicroS, decMicroS));
-        }
-        else {
-            std::cerr << "Validation complete. Unsuccessful:\n"
-                        << error_count << " missmatched values!\n";
+    }
+    return error_count;
+}
+
+/**
+ * @brief Records the boundaries of the Put, FlushValues, SetData and Decode phases of one roundtrip.
+ *        If counters are given they are also read for every phase. That costs a few µs per
+ *        boundary, so counter runs are kept apart from the timed runs
+ */
+class RoundtripProbe {
+public:
+    explicit RoundtripProbe(PerfCounters *counters) : counters(counters), next_boundary(0) {}
+
+    /**
+     * @brief Marks the start of the first phase, the switch to the next phase or the end of the last
+     */
+    void mark() {
+        if(counters != nullptr && next_boundary > 0) readings.at(next_boundary-1) = counters->stop();
+        boundaries.at(next_boundary++) = timestamp();
+        if(counters != nullptr && next_boundary <= RoundtripPhaseCount) counters->start();
+    }
+
+    std::array<Timestamp, RoundtripPhaseCount+1> boundaries;
+    std::array<PerfReading, RoundtripPhaseCount> readings;
+    //size of the buffer returned by FlushValues plus the dictionary page
+    int64_t encoded_bytes{0};
+
+private:
+    PerfCounters *counters;
+    int next_boundary;
+};
+
+/**
+ * @brief Range of phases [first, second) that is reported as encode or decode time
+ */
+using PhaseRange = std::pair<RoundtripPhase, RoundtripPhase>;
+const PhaseRange encodePhases{RoundtripPhase::Put, RoundtripPhase::SetData};
+const PhaseRange decodePhases{RoundtripPhase::SetData, static_cast<RoundtripPhase>(RoundtripPhaseCount)};
+
+/**
+ * @brief Whether the encoding selects a dictionary encoder
+ */
+bool is_dictionary(parquet::Encoding::type encoding) {
+    return encoding == parquet::Encoding::PLAIN_DICTIONARY || encoding == parquet::Encoding::RLE_DICTIONARY;
+}
+
+/**
+ * @brief Median of every counter over the given readings divided by value_count
+ */
+PerfReading median_per_value(const std::vector<PerfReading> &readings, int64_t value_count) {
+    PerfReading result;
+    for(int e=0; e<PerfEventCount; ++e) {
+        std::vector<double> values;
+        for(const auto &reading : readings) {
+            if(reading.valid.at(e)) values.push_back(reading.values.at(e));
+        }
+        if(values.empty()) continue;
+        result.values.at(e) = compute_statistics(values).median/value_count;
+        result.valid.at(e) = true;
+    }
+    return result;
+}
+
+/**
+ * @brief Runs the warm-up roundtrips and then measures roundtrips until sample_repeat samples
+ *        are taken or, in adaptive mode, the confidence intervals of both phases are tight enough
+ *
+ * @param options The number of warm-up and measured repetitions
+ * @param value_count The number of values encoded in one roundtrip
+ * @param input_bytes The size of the unencoded values in bytes
+ * @param pool Pool whose allocations are counted per roundtrip, may be nullptr
+ * @param run_once Callable performing one roundtrip that marks its phase boundaries in the
+ *                 RoundtripProbe it is given and returns false if the roundtrip should not be counted
+ * @return RoundtripResult statistics over all counted roundtrips
+ */
+template<typename Roundtrip>
+RoundtripResult collect_samples(const RoundtripOptions &options, int64_t value_count, int64_t input_bytes,
+                                TrackingMemoryPool *pool, Roundtrip run_once) {
+    RoundtripResult result{};
+    result.value_count = value_count;
+    result.input_bytes = input_bytes;
+    std::vector<double> encode_cycles;
+    std::vector<double> decode_cycles;
+    std::vector<double> allocations;
+    std::vector<double> allocated_bytes;
+    std::vector<double> peak_bytes;
+    std::array<std::vector<double>, RoundtripPhaseCount> phase_samples;
+    auto elapsed = [](const RoundtripProbe &probe, PhaseRange range) {
+        const Timestamp &start = probe.boundaries.at(static_cast<int>(range.first));
+        const Timestamp &end = probe.boundaries.at(static_cast<int>(range.second));
+        return std::make_pair(static_cast<double>(end.ns-start.ns), static_cast<double>(end.tsc-start.tsc));
+    };
+    for(int i=0; i<options.warmup; ++i) {
+        RoundtripProbe probe(nullptr);
+        run_once(probe);
+    }
+    for(int i=0; i<options.sample_repeat; ++i) {
+        RoundtripProbe probe(nullptr);
+        const int64_t allocationsBefore = pool != nullptr ? pool->allocations() : 0;
+        const int64_t bytesBefore = pool != nullptr ? pool->allocated_bytes() : 0;
+        if(pool != nullptr) pool->reset_peak();
+        if(!run_once(probe)) continue;
+        if(pool != nullptr) {
+            allocations.push_back(static_cast<double>(pool->allocations()-allocationsBefore));
+            allocated_bytes.push_back(static_cast<double>(pool->allocated_bytes()-bytesBefore));
+            peak_bytes.push_back(static_cast<double>(pool->peak_bytes()));
+        }
+        result.encoded_bytes = probe.encoded_bytes;
+        auto encodeTime = elapsed(probe, encodePhases);
+        auto decodeTime = elapsed(probe, decodePhases);
+        result.encode_samples.push_back(encodeTime.first);
+        result.decode_samples.push_back(decodeTime.first);
+        encode_cycles.push_back(encodeTime.second);
+        decode_cycles.push_back(decodeTime.second);
+        for(int p=0; p<RoundtripPhaseCount; ++p) {
+            phase_samples.at(p).push_back(elapsed(probe, {static_cast<RoundtripPhase>(p),
+                                                          static_cast<RoundtripPhase>(p+1)}).first);
         }
+        if(options.adaptive && static_cast<int>(result.encode_samples.size()) >= options.min_samples) {
+            if(compute_statistics(result.encode_samples).relative_ci() <= options.ci_target &&
+               compute_statistics(result.decode_samples).relative_ci() <= options.ci_target) {
+                break;
+            }
+        }
+    }
+    if(result.encode_samples.empty()) {
+        throw std::runtime_error("No roundtrip validated successfully");
     }
+    result.encode = compute_statistics(result.encode_samples);
+    result.decode = compute_statistics(result.decode_samples);
+    result.encode_cycles = compute_statistics(encode_cycles);
+    result.decode_cycles = compute_statistics(decode_cycles);
+    for(int p=0; p<RoundtripPhaseCount; ++p) {
+        result.phases.at(p) = compute_statistics(phase_samples.at(p));
+    }
+    result.allocations = compute_statistics(allocations).median;
+    result.allocated_bytes = compute_statistics(allocated_bytes).median;
+    result.peak_bytes = compute_statistics(peak_bytes).median;
 
-    //calculate minimum
-    std::sort(measurements.begin(), measurements.end(),
-    [](std::pair<int64_t, int64_t> a, std::pair<int64_t, int64_t> b){return a.first < b.first;});
-    return measurements.at(0);
+    if(options.perf_counters) {
+        PerfCounters counters;
+        if(counters.available()) {
+            std::array<std::vector<PerfReading>, RoundtripPhaseCount> readings;
+            for(int i=0; i<options.counter_samples; ++i) {
+                RoundtripProbe probe(&counters);
+                if(!run_once(probe)) continue;
+                for(int p=0; p<RoundtripPhaseCount; ++p) readings.at(p).push_back(probe.readings.at(p));
+            }
+            for(int p=0; p<RoundtripPhaseCount; ++p) {
+                result.phase_counters.at(p) = median_per_value(readings.at(p), value_count);
+            }
+        }
+    }
+    return result;
 }
 
 /**
- * @brief Executes a set amout of parquet-encoder(DELTA_BINARY_PACKED encoding) roundtrips with the given data
- *        and returns the best measurement pair (sorted by encoding time) in µs
- * 
- * @param sample_repeat the number of 
- * @param in_data An int32_t vector containing the data to be used for the round trips
- * @return std::pair<int64_t, int64_t> a pair of (encode time, decode time) in µs
+ * @brief Decodes a DELTA_BINARY_PACKED page with delta_decode_parallel at the best SIMD level.
+ *        Other types have no parallel decoder
+ *
+ * @return the number of values decoded
+ * @throw std::invalid_argument for other types
  */
-std::pair<int64_t, int64_t> encoder_roundtrip(int sample_repeat, std::vector<int32_t> &in_data) {
-    //test repeatedly and pick minimum result
-    std::vector<std::pair<int64_t, int64_t>> measurements;
-    for(int i=0; i<sample_repeat; ++i) {
-        //________________start_test________________
-        auto node = parquet::schema::Int32("Test", parquet::Repetition::REQUIRED);
-        auto columnDescr = std::make_shared<parquet::ColumnDescriptor>(node, 0, 0);
+template<typename T>
+int decode_page_parallel(const arrow::Buffer &page, std::vector<T> &out_data, int threads) {
+    if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>) {
+        return static_cast<int>(delta_decode_parallel(page.data(), page.size(), out_data.data(),
+                                                      static_cast<int64_t>(out_data.size()),
+                                                      detect_simd_level(), threads));
+    } else {
+        throw std::invalid_argument("Parallel decoding needs an INT32 or INT64 column");
+    }
+}
 
-        auto encoder =
-            parquet::MakeTypedEncoder<parquet::Int32Type>(parquet::Encoding::DELTA_BINARY_PACKED, false, columnDescr.get());
-        auto decoder = parquet::MakeTypedDecoder<parquet::Int32Type>(parquet::Encoding::DELTA_BINARY_PACKED, columnDescr.get());
+/**
+ * @brief Number of miniblocks per bit width of a DELTA_BINARY_PACKED page of T, indexed by the width
+ *        up to the bit width of T
+ */
+template<typename T>
+std::vector<int64_t> miniblock_bit_widths(const uint8_t *page, int64_t size) {
+    const DeltaPageLayout layout = inspect_delta_page(page, size);
+    const size_t widths = std::min(8*sizeof(T)+1, layout.bit_widths.size());
+    return {layout.bit_widths.begin(), layout.bit_widths.begin()+static_cast<std::ptrdiff_t>(widths)};
+}
 
-        std::vector<int32_t> out_data;
-        out_data.resize(in_data.size());
+/**
+ * @brief Measures roundtrips of one page through the encoder and decoder of the encoding, creating
+ *        them per roundtrip or once in steady state mode. The callables encode the input and decode
+ *        it again, so the same engine serves raw pointers, spaced values and Arrow arrays
+ *
+ * @param value_count The number of slots in the page
+ * @param null_count The number of null slots, only the others are stored in the page
+ * @param input_bytes The size of the unencoded non-null values in bytes
+ * @param nullable Whether the column is OPTIONAL (max definition level 1) instead of REQUIRED
+ * @param set_data Whether decode reads the page through the decoder it is given. Otherwise SetData is
+ *                 skipped, so the SetData phase stays empty and decode is timed alone
+ * @param put Callable encoding the input with the parquet::TypedEncoder<DType> * it is given
+ * @param decode Callable decoding value_count slots with the parquet::TypedDecoder<DType> * it is
+ *               given, may allocate from the arrow::MemoryPool * it is given, returns the slot count.
+ *               It is also given the encoded page as const arrow::Buffer &
+ * @param validate Callable returning the number of mismatched values after decode, it is given the
+ *                 encoded page as const arrow::Buffer &
+ * @return DELTA_BINARY_PACKED results include the bit widths of the first page
+ */
+template<typename DType, typename PutFn, typename DecodeFn, typename ValidateFn>
+RoundtripResult run_roundtrips(const RoundtripOptions &options, int64_t value_count, int64_t null_count,
+                               int64_t input_bytes, parquet::Encoding::type encoding, bool nullable,
+                               bool set_data, PutFn put, DecodeFn decode, ValidateFn validate) {
+    if(!encoding_supported(DType::type_num, encoding)) {
+        throw std::invalid_argument(parquet::EncodingToString(encoding) + " is not supported for "
+                                    + parquet::TypeToString(DType::type_num) + " columns");
+    }
+    const bool dictionary = is_dictionary(encoding);
+    //the pool has to outlive the encoders and decoders that allocate from it
+    TrackingMemoryPool pool(backend_memory_pool(options.memory_pool));
+    std::shared_ptr<parquet::ColumnDescriptor> columnDescr;
+    std::unique_ptr<parquet::TypedEncoder<DType>> encoder;
+    //decodes the data page of non-dictionary encodings
+    std::unique_ptr<parquet::TypedDecoder<DType>> decoder;
+    //dictionary encodings: PLAIN decoder of the dictionary page and decoder of the indices
+    std::unique_ptr<parquet::TypedDecoder<DType>> dictPageDecoder;
+    std::unique_ptr<parquet::DictDecoder<DType>> dictDecoder;
+    auto setup = [&]() {
+        auto node = parquet::schema::PrimitiveNode::Make("Test", nullable ? parquet::Repetition::OPTIONAL
+                                                                          : parquet::Repetition::REQUIRED,
+                                                         DType::type_num);
+        columnDescr = std::make_shared<parquet::ColumnDescriptor>(node, nullable ? 1 : 0, 0);
+        if(dictionary) {
+            //the dictionary encoder falls back to PLAIN once told to, which never happens here
+            encoder = parquet::MakeTypedEncoder<DType>(parquet::Encoding::PLAIN, true, columnDescr.get(), &pool);
+            dictPageDecoder = parquet::MakeTypedDecoder<DType>(parquet::Encoding::PLAIN, columnDescr.get(), &pool);
+            dictDecoder = parquet::MakeDictDecoder<DType>(columnDescr.get(), &pool);
+        } else {
+            encoder = parquet::MakeTypedEncoder<DType>(encoding, false, columnDescr.get(), &pool);
+            decoder = parquet::MakeTypedDecoder<DType>(encoding, columnDescr.get(), &pool);
+        }
+    };
+    if(options.steady_state) setup();
+    std::vector<int64_t> bitWidths;
+    RoundtripResult result = collect_samples(options, value_count, input_bytes, &pool, [&](RoundtripProbe &probe) {
+        //________________start_test________________
+        if(!options.steady_state) setup();
         //start timing encoding
-        const auto startE = std::chrono::steady_clock::now();
-        //encode
-        encoder->Put(in_data.data(), in_data.size());
+        probe.mark();
+        //encode, FlushValues resets the encoder for the next roundtrip
+        put(encoder.get());
+        probe.mark();
         auto encode_buffer = encoder->FlushValues();
+        std::shared_ptr<arrow::ResizableBuffer> dict_buffer;
+        int dict_entries{0};
+        if(dictionary) {
+            auto dictEncoder = dynamic_cast<parquet::DictEncoder<DType> *>(encoder.get());
+            dict_buffer = parquet::AllocateBuffer(&pool, dictEncoder->dict_encoded_size());
+            dictEncoder->WriteDict(dict_buffer->mutable_data());
+            dict_entries = dictEncoder->num_entries();
+        }
         //stop timing encoding & start timeing decoding
-        const auto mid = std::chrono::steady_clock::now();
-        //decode
-        decoder->SetData(in_data.size(), encode_buffer->data(),
-                            static_cast<int>(encode_buffer->size()));
-        int values_decoded = decoder->Decode(out_data.data(), out_data.size());
+        probe.mark();
+        probe.encoded_bytes = encode_buffer->size() + (dict_buffer ? dict_buffer->size() : 0);
+        //decode, SetData resets the decoder
+        parquet::TypedDecoder<DType> *valueDecoder = decoder.get();
+        if(dictionary) {
+            dictPageDecoder->SetData(dict_entries, dict_buffer->data(), static_cast<int>(dict_buffer->size()));
+            dictDecoder->SetDict(dictPageDecoder.get());
+            valueDecoder = dictDecoder.get();
+        }
+        //the page holds only the non-null values
+        if(set_data) {
+            valueDecoder->SetData(static_cast<int>(value_count-null_count), encode_buffer->data(),
+                                  static_cast<int>(encode_buffer->size()));
+        }
+        probe.mark();
+        int values_decoded = decode(valueDecoder, static_cast<arrow::MemoryPool *>(&pool), *encode_buffer);
         //stop timing decoding
-        const auto endE = std::chrono::steady_clock::now();
+        probe.mark();
         //check output volume
-        if(values_decoded != in_data.size()) {
-            std::cerr << "Decoded " << values_decoded << " values but expected " << in_data.size() << " !\n";
+        if(values_decoded != value_count) {
+            std::cerr << "Decoded " << values_decoded << " values but expected " << value_count << " !\n";
         }
         //validate data
-        int error_count{0};
-        int err_output_limit{10};
-        for(int i = 0; i < in_data.size(); ++i) {
-            int32_t in{in_data.at(i)};
-            int32_t out{out_data.at(i)};
-            if(in != out) {
-                ++error_count;
-                if( err_output_limit < 0 || error_count <= err_output_limit)
-                std::cerr << "Mismatching value #" << i << "was expected to be "
-                            << in << " but was " << out << '\n';
-                if(error_count == err_output_limit) {
-                    std::cerr << "Too many mismatched values! Omitting output...\n";
-                }
-            }
+        int error_count = validate(*encode_buffer);
+        //the pages of all roundtrips are the same
+        if(encoding == parquet::Encoding::DELTA_BINARY_PACKED && bitWidths.empty()) {
+            bitWidths = miniblock_bit_widths<typename DType::c_type>(encode_buffer->data(), encode_buffer->size());
         }
-        //TODO measuring validation failures just for performance proof of concept
-        if(/*error_count == 0*/true) {
-            //time encoding took in µs
-            auto encMicroS =
-            std::chrono::duration_cast<std::chrono::microseconds>(mid-startE).count();
-            //time decoding took in µs
-            auto decMicroS =
-            std::chrono::duration_cast<std::chrono::microseconds>(endE-mid).count();
-            //add this runs measurements to the list
-            measurements.push_back(std::make_pair(encMicroS, decMicroS));
-        }
-        else {
+        if(error_count != 0) {
             std::cerr << "Validation complete. Unsuccessful:\n"
                         << error_count << " missmatched values!\n";
+            return false;
         }
-    }
-
-    //calculate minimum
-    std::sort(measurements.begin(), measurements.end(),
-    [](std::pair<int64_t, int64_t> a, std::pair<int64_t, int64_t> b){return a.first < b.first;});
-    return measurements.at(0);
+        return true;
+    });
+    result.bit_widths = std::move(bitWidths);
+    return result;
 }
 
 /**
- * @brief Executes a set amout of parquet-encoder(DELTA_BINARY_PACKED encoding) roundtrips with the given data
- *        and returns the best measurement pair (sorted by encoding time) in µs
- * 
- * @param sample_repeat the number of 
- * @param in_data An int64_t vector containing the data to be used for the round trips
- * @return std::pair<int64_t, int64_t> a pair of (encode time, decode time) in µs
+ * @brief Checks that the reference codec of every supported SIMD level writes Arrow's
+ *        DELTA_BINARY_PACKED page byte for byte and decodes it to the input. Other types have no
+ *        reference codec and are not checked
+ *
+ * @throw std::runtime_error on the first difference
  */
-std::pair<int64_t, int64_t> encoder_detailed_roundtrip(int sample_repeat, std::vector<int64_t> &in_data) {
-    //test repeatedly and pick minimum result
-    std::vector<std::pair<int64_t, int64_t>> measurements;
-    for(int i=0; i<sample_repeat; ++i) {
-        //________________start_test________________
-        auto node = parquet::schema::Int64("Test", parquet::Repetition::REQUIRED);
-        auto columnDescr = std::make_shared<parquet::ColumnDescriptor>(node, 0, 0);
+template<typename T>
+void cross_validate_delta_page(const T *in_data, int64_t value_count, const arrow::Buffer &page) {
+    if constexpr (std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value) {
+        std::vector<uint8_t> reference;
+        std::vector<T> decoded(value_count);
+        for(SimdLevel level : supported_simd_levels()) {
+            const std::string codec = std::string("Reference DELTA_BINARY_PACKED codec (") + simd_level_name(level) + ")";
+            const int64_t size = delta_encode(in_data, value_count, reference, level);
+            const int64_t common = std::min(size, page.size());
+            const int64_t firstDifference = std::mismatch(reference.data(), reference.data()+common, page.data()).first
+                                            - reference.data();
+            if(size != page.size() || firstDifference != common) {
+                throw std::runtime_error(codec + " wrote a " + std::to_string(size) + " byte page, Arrow "
+                                         + std::to_string(page.size()) + " bytes, first difference at byte "
+                                         + std::to_string(firstDifference));
+            }
+            if(delta_decode(page.data(), page.size(), decoded.data(), value_count, level) != value_count
+               || !std::equal(decoded.begin(), decoded.end(), in_data)) {
+                throw std::runtime_error(codec + " did not decode Arrow's page to the input");
+            }
+        }
+    }
+}
 
-        auto encoder =
-            parquet::MakeTypedEncoder<parquet::Int64Type>(parquet::Encoding::DELTA_BINARY_PACKED, false, columnDescr.get());
-        auto decoder = parquet::MakeTypedDecoder<parquet::Int64Type>(parquet::Encoding::DELTA_BINARY_PACKED, columnDescr.get());
+} // namespace
 
-        std::vector<int64_t> out_data;
-        out_data.resize(in_data.size());
-        //start timing encoding
-        const auto startE = std::chrono::steady_clock::now();
-        //encode
-        encoder->Put(in_data.data(), in_data.size());
-        //stop timing put & start timeing flush
-        const auto mid = std::chrono::steady_clock::now();
-        auto encode_buffer = encoder->FlushValues();
-        //stop timing encoding
-        const auto endE = std::chrono::steady_clock::now();
+bool encoding_supported(parquet::Type::type type, parquet::Encoding::type encoding) {
+    switch(encoding) {
+        case parquet::Encoding::PLAIN:
+            return true;
+        case parquet::Encoding::PLAIN_DICTIONARY:
+        case parquet::Encoding::RLE_DICTIONARY:
+            return type != parquet::Type::BOOLEAN;
+        case parquet::Encoding::RLE:
+            return type == parquet::Type::BOOLEAN;
+        case parquet::Encoding::DELTA_BINARY_PACKED:
+            return type == parquet::Type::INT32 || type == parquet::Type::INT64;
+        case parquet::Encoding::DELTA_LENGTH_BYTE_ARRAY:
+        case parquet::Encoding::DELTA_BYTE_ARRAY:
+            return type == parquet::Type::BYTE_ARRAY;
+        case parquet::Encoding::BYTE_STREAM_SPLIT:
+#if ARROW_VERSION_MAJOR >= 17
+            //integer and fixed length byte array support was added in Arrow 17
+            if(type == parquet::Type::INT32 || type == parquet::Type::INT64) return true;
+#endif
+            return type == parquet::Type::FLOAT || type == parquet::Type::DOUBLE;
+        default:
+            return false;
+    }
+}
 
-        //decode
-        decoder->SetData(in_data.size(), encode_buffer->data(),
-                            static_cast<int>(encode_buffer->size()));
-        int values_decoded = decoder->Decode(out_data.data(), out_data.size());
+parquet::Encoding::type parse_encoding(const std::string &name) {
+    for(auto encoding : {parquet::Encoding::PLAIN, parquet::Encoding::PLAIN_DICTIONARY, parquet::Encoding::RLE,
+                         parquet::Encoding::DELTA_BINARY_PACKED, parquet::Encoding::DELTA_LENGTH_BYTE_ARRAY,
+                         parquet::Encoding::DELTA_BYTE_ARRAY, parquet::Encoding::RLE_DICTIONARY,
+                         parquet::Encoding::BYTE_STREAM_SPLIT}) {
+        if(name == parquet::EncodingToString(encoding)) return encoding;
+    }
+    throw std::invalid_argument("Unknown encoding: " + name);
+}
 
-        //check output volume
-        if(values_decoded != in_data.size()) {
-            std::cerr << "Decoded " << values_decoded << " values but expected " << in_data.size() << " !\n";
-        }
-        //validate data
-        int error_count{0};
-        int err_output_limit{10};
-        for(int i = 0; i < in_data.size(); ++i) {
-            int64_t in{in_data.at(i)};
-            int64_t out{out_data.at(i)};
-            if(in != out) {
-                ++error_count;
-                if( err_output_limit < 0 || error_count <= err_output_limit)
-                std::cerr << "Mismatching value #" << i << "was expected to be "
-                            << in << " but was " << out << '\n';
-                if(error_count == err_output_limit) {
-                    std::cerr << "Too many mismatched values! Omitting output...\n";
-                }
+template<typename DType>
+RoundtripResult encoder_roundtrip(const RoundtripOptions &options, const typename DType::c_type *in_data,
+                                  int64_t value_count, parquet::Encoding::type encoding) {
+    std::vector<typename DType::c_type> out_data(value_count);
+    //the first page is compared to the reference codec, the others are the same
+    bool crossValidated{encoding != parquet::Encoding::DELTA_BINARY_PACKED};
+    const bool parallelDecode = encoding == parquet::Encoding::DELTA_BINARY_PACKED && options.decode_threads > 0;
+    return run_roundtrips<DType>(options, value_count, 0, payload_bytes(in_data, value_count, nullptr, 0),
+                                 encoding, false, !parallelDecode,
+                                 [&](parquet::TypedEncoder<DType> *encoder) {
+                                     encoder->Put(in_data, static_cast<int>(value_count));
+                                 },
+                                 [&](parquet::TypedDecoder<DType> *decoder, arrow::MemoryPool *,
+                                     const arrow::Buffer &page) {
+                                     if(parallelDecode) {
+                                         return decode_page_parallel(page, out_data, options.decode_threads);
+                                     }
+                                     return decoder->Decode(out_data.data(), static_cast<int>(value_count));
+                                 },
+                                 [&](const arrow::Buffer &page) {
+                                     const int mismatches = count_mismatches(in_data, out_data, nullptr);
+                                     if(!crossValidated) cross_validate_delta_page(in_data, value_count, page);
+                                     crossValidated = true;
+                                     return mismatches;
+                                 });
+}
+
+template<typename DType>
+RoundtripResult encoder_spaced_roundtrip(const RoundtripOptions &options, const typename DType::c_type *in_data,
+                                         int64_t value_count, const uint8_t *valid_bits,
+                                         parquet::Encoding::type encoding) {
+    int64_t null_count{0};
+    for(int64_t i=0; i<value_count; ++i) {
+        if(!is_valid(valid_bits, i)) ++null_count;
+    }
+    std::vector<typename DType::c_type> out_data(value_count);
+    return run_roundtrips<DType>(options, value_count, null_count,
+                                 payload_bytes(in_data, value_count, valid_bits, null_count), encoding, true, true,
+                                 [&](parquet::TypedEncoder<DType> *encoder) {
+                                     encoder->PutSpaced(in_data, static_cast<int>(value_count), valid_bits, 0);
+                                 },
+                                 [&](parquet::TypedDecoder<DType> *decoder, arrow::MemoryPool *,
+                                     const arrow::Buffer &) {
+                                     return decoder->DecodeSpaced(out_data.data(), static_cast<int>(value_count),
+                                                                  static_cast<int>(null_count), valid_bits, 0);
+                                 },
+                                 [&](const arrow::Buffer &) {
+                                     return count_mismatches(in_data, out_data, valid_bits);
+                                 });
+}
+
+RoundtripResult encoder_arrow_roundtrip(const RoundtripOptions &options, const arrow::Int64Array &array,
+                                        parquet::Encoding::type encoding) {
+    const int64_t value_count = array.length();
+    const int64_t null_count = array.null_count();
+    std::shared_ptr<arrow::Array> decoded;
+    return run_roundtrips<parquet::Int64Type>(
+        options, value_count, null_count, (value_count-null_count)*static_cast<int64_t>(sizeof(int64_t)),
+        encoding, null_count > 0, true,
+        [&](parquet::TypedEncoder<parquet::Int64Type> *encoder) {
+            encoder->Put(array);
+        },
+        [&](parquet::TypedDecoder<parquet::Int64Type> *decoder, arrow::MemoryPool *pool, const arrow::Buffer &) {
+            //the accumulator the Arrow column reader decodes INT64 pages into
+            typename parquet::EncodingTraits<parquet::Int64Type>::Accumulator builder(pool);
+            const int decoded_count = null_count > 0
+                ? decoder->DecodeArrow(static_cast<int>(value_count), static_cast<int>(null_count),
+                                       array.null_bitmap_data(), array.offset(), &builder)
+                : decoder->DecodeArrowNonNull(static_cast<int>(value_count), &builder);
+            PARQUET_THROW_NOT_OK(builder.Finish(&decoded));
+            return decoded_count;
+        },
+        [&](const arrow::Buffer &) {
+            if(decoded->Equals(array)) return 0;
+            if(decoded->length() != value_count) return static_cast<int>(std::max<int64_t>(value_count, 1));
+            const auto &out = static_cast<const arrow::Int64Array &>(*decoded);
+            std::vector<int64_t> out_data(out.raw_values(), out.raw_values()+out.length());
+            std::vector<uint8_t> valid_bits((value_count+7)/8, 0xff);
+            for(int64_t i=0; i<value_count; ++i) {
+                if(array.IsNull(i)) valid_bits[i >> 3] &= static_cast<uint8_t>(~(1u << (i & 7)));
             }
+            const int mismatches = count_mismatches(array.raw_values(), out_data, valid_bits.data());
+            //a differing validity bitmap counts as one mismatch
+            return mismatches > 0 ? mismatches : 1;
+        });
+}
+
+template<typename T>
+RoundtripResult reference_delta_roundtrip(const RoundtripOptions &options, const T *in_data, int64_t value_count,
+                                          SimdLevel level, UnpackKernel unpack) {
+    std::vector<uint8_t> page;
+    std::vector<T> out_data(value_count);
+    int64_t pageSize{0};
+    RoundtripResult result = collect_samples(options, value_count, value_count*static_cast<int64_t>(sizeof(T)), nullptr,
+                           [&](RoundtripProbe &probe) {
+        probe.mark();
+        const int64_t size = delta_encode(in_data, value_count, page, level);
+        //the page is complete after encoding, nothing to flush
+        probe.mark();
+        probe.mark();
+        probe.encoded_bytes = size;
+        pageSize = size;
+        const DeltaPageHeader header = parse_delta_header(page.data(), size);
+        probe.mark();
+        const int64_t values_decoded = delta_decode(page.data(), size, out_data.data(), value_count, level, unpack);
+        probe.mark();
+        if(values_decoded != value_count || header.value_count != value_count) {
+            std::cerr << "Decoded " << values_decoded << " values but expected " << value_count << " !\n";
         }
-        if(error_count == 0) {
-            //time encoding took in µs
-            auto encMicroS =
-            std::chrono::duration_cast<std::chrono::microseconds>(mid-startE).count();
-            //time decoding took in µs
-            auto decMicroS =
-            std::chrono::duration_cast<std::chrono::microseconds>(endE-mid).count();
-            //add this runs measurements to the list
-            measurements.push_back(std::make_pair(encMicroS, decMicroS));
-        }
-        else {
+        int error_count = count_mismatches(in_data, out_data, nullptr);
+        if(error_count != 0) {
             std::cerr << "Validation complete. Unsuccessful:\n"
                         << error_count << " missmatched values!\n";
+            return false;
         }
+        return true;
+    });
+    result.bit_widths = miniblock_bit_widths<T>(page.data(), pageSize);
+    return result;
+}
+
+template RoundtripResult encoder_roundtrip<parquet::Int32Type>(const RoundtripOptions &, const int32_t *,
+                                                                int64_t, parquet::Encoding::type);
+template RoundtripResult encoder_roundtrip<parquet::Int64Type>(const RoundtripOptions &, const int64_t *,
+                                                                int64_t, parquet::Encoding::type);
+template RoundtripResult encoder_roundtrip<parquet::FloatType>(const RoundtripOptions &, const float *,
+                                                                int64_t, parquet::Encoding::type);
+template RoundtripResult encoder_roundtrip<parquet::DoubleType>(const RoundtripOptions &, const double *,
+                                                                 int64_t, parquet::Encoding::type);
+template RoundtripResult encoder_roundtrip<parquet::ByteArrayType>(const RoundtripOptions &,
+                                                                    const parquet::ByteArray *,
+                                                                    int64_t, parquet::Encoding::type);
+
+template RoundtripResult encoder_spaced_roundtrip<parquet::Int32Type>(const RoundtripOptions &, const int32_t *,
+                                                                       int64_t, const uint8_t *,
+                                                                       parquet::Encoding::type);
+template RoundtripResult encoder_spaced_roundtrip<parquet::Int64Type>(const RoundtripOptions &, const int64_t *,
+                                                                       int64_t, const uint8_t *,
+                                                                       parquet::Encoding::type);
+template RoundtripResult encoder_spaced_roundtrip<parquet::FloatType>(const RoundtripOptions &, const float *,
+                                                                       int64_t, const uint8_t *,
+                                                                       parquet::Encoding::type);
+template RoundtripResult encoder_spaced_roundtrip<parquet::DoubleType>(const RoundtripOptions &, const double *,
+                                                                        int64_t, const uint8_t *,
+                                                                        parquet::Encoding::type);
+template RoundtripResult encoder_spaced_roundtrip<parquet::ByteArrayType>(const RoundtripOptions &,
+                                                                           const parquet::ByteArray *, int64_t,
+                                                                           const uint8_t *, parquet::Encoding::type);
+
+template RoundtripResult reference_delta_roundtrip<int32_t>(const RoundtripOptions &, const int32_t *, int64_t,
+                                                            SimdLevel, UnpackKernel);
+template RoundtripResult reference_delta_roundtrip<int64_t>(const RoundtripOptions &, const int64_t *, int64_t,
+                                                            SimdLevel, UnpackKernel);
+
+void print_memory_usage(std::ostream &os, const RoundtripResult &result) {
+    os << "Encoded size\t" << result.encoded_bytes << " bytes (ratio " << result.compression_ratio()
+       << ", " << static_cast<double>(result.encoded_bytes)*8/result.value_count << " bits/value)\n"
+       << "Memory pool\t" << result.allocations << " allocations, " << result.allocated_bytes
+       << " bytes allocated, peak " << result.peak_bytes << " bytes per roundtrip\n";
+}
+
+void print_bit_widths(std::ostream &os, const RoundtripResult &result) {
+    if(result.bit_widths.empty()) return;
+    const int64_t miniblocks = miniblock_count(result.bit_widths);
+    os << "Miniblocks\t" << miniblocks << ", mean bit width " << mean_bit_width(result.bit_widths) << '\n';
+    if(miniblocks == 0) return;
+    os << "Bit width:";
+    for(size_t width=0; width<result.bit_widths.size(); ++width) {
+        if(result.bit_widths[width] == 0) continue;
+        os << '\t' << width << ": " << 100.0*result.bit_widths[width]/miniblocks << '%';
     }
+    os << '\n';
+}
 
-    //calculate minimum
-    std::sort(measurements.begin(), measurements.end(),
-    [](std::pair<int64_t, int64_t> a, std::pair<int64_t, int64_t> b){return a.first < b.first;});
-    return measurements.at(0);
+void print_phase_counters(std::ostream &os, const RoundtripResult &result) {
+    static const std::array<const char *, RoundtripPhaseCount> phaseNames{{"Put", "FlushValues", "SetData", "Decode"}};
+    bool any{false};
+    for(const auto &reading : result.phase_counters) {
+        for(bool valid : reading.valid) any = any || valid;
+    }
+    if(!any) {
+        os << "Hardware counters unavailable (perf_event_open failed or was not requested)\n";
+        return;
+    }
+    os << "Per value:\tcycles\tinstr\tIPC";
+    for(PerfEvent event : {PerfEvent::L1dMisses, PerfEvent::LlcMisses, PerfEvent::BranchMisses, PerfEvent::DtlbMisses}) {
+        os << '\t' << PerfCounters::name(event);
+    }
+    os << '\n';
+    for(int p=0; p<RoundtripPhaseCount; ++p) {
+        const PerfReading &reading = result.phase_counters.at(p);
+        auto print = [&](PerfEvent event) {
+            if(reading.has(event)) os << '\t' << reading[event];
+            else os << "\tn/a";
+        };
+        os << phaseNames.at(p);
+        print(PerfEvent::Cycles);
+        print(PerfEvent::Instructions);
+        if(reading.has(PerfEvent::Cycles) && reading.has(PerfEvent::Instructions) && reading[PerfEvent::Cycles] > 0) {
+            os << '\t' << reading[PerfEvent::Instructions]/reading[PerfEvent::Cycles];
+        } else {
+            os << "\tn/a";
+        }
+        print(PerfEvent::L1dMisses);
+        print(PerfEvent::LlcMisses);
+        print(PerfEvent::BranchMisses);
+        print(PerfEvent::DtlbMisses);
+        os << '\n';
+    }
 }
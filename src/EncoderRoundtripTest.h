@@ -1,30 +1,237 @@
 #pragma once
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/type_fwd.h"
+#include "parquet/types.h"
+
+#include "DeltaBitPackCodec.h"
+#include "PerfCounters.h"
+#include "RoundtripStatistics.h"
+#include "TrackingMemoryPool.h"
+
+/**
+ * @brief The steps of a roundtrip in the order they are executed
+ */
+enum class RoundtripPhase {
+    Put,
+    FlushValues,
+    SetData,
+    Decode
+};
+constexpr int RoundtripPhaseCount{4};
+
+/**
+ * @brief Controls how many roundtrips are measured
+ */
+struct RoundtripOptions {
+    //maximum number of measured roundtrips
+    int sample_repeat{100};
+    //number of roundtrips run before measuring, their timings are discarded
+    int warmup{5};
+    //stop early once the confidence intervals of encode and decode are tight enough
+    bool adaptive{false};
+    //adaptive mode: target half-width of the 95% confidence interval relative to the mean
+    double ci_target{0.01};
+    //adaptive mode: number of samples measured before the first check
+    int min_samples{10};
+    //read hardware performance counters for every phase in additional, untimed roundtrips
+    bool perf_counters{false};
+    //number of untimed roundtrips the counters are read in
+    int counter_samples{10};
+    //allocator the encoder and decoder allocate from in roundtrips that track their allocations
+    MemoryPoolBackend memory_pool{MemoryPoolBackend::Default};
+    //create schema, encoder, decoder and output once and reuse them for all roundtrips, so only the
+    //allocations the codec itself makes per page remain
+    bool steady_state{false};
+    //encoder_roundtrip of DELTA_BINARY_PACKED integer columns: 0 decodes with Arrow's decoder, n > 0
+    //decodes the page FlushValues returned with delta_decode_parallel on n threads instead
+    int decode_threads{0};
+};
+
+/**
+ * @brief Timing statistics of a set of roundtrips, all times in ns
+ */
+struct RoundtripResult {
+    //number of values encoded in one roundtrip
+    int64_t value_count;
+    SampleStatistics encode;
+    SampleStatistics decode;
+    //time stamp counter ticks per roundtrip, all zero if the platform has no TSC
+    SampleStatistics encode_cycles;
+    SampleStatistics decode_cycles;
+    //time of every phase, indexed by RoundtripPhase
+    std::array<SampleStatistics, RoundtripPhaseCount> phases;
+    //median hardware counter values per value of every phase, indexed by RoundtripPhase,
+    //all invalid unless options.perf_counters is set and the counters are available
+    std::array<PerfReading, RoundtripPhaseCount> phase_counters;
+    //median number of allocations, allocated bytes and peak bytes held by the memory pool per
+    //measured roundtrip, 0 unless the roundtrip allocates from a TrackingMemoryPool
+    double allocations;
+    double allocated_bytes;
+    double peak_bytes;
+    //size of the unencoded input (for byte arrays the sum of their lengths) and of the encoded
+    //data including a dictionary page in bytes
+    int64_t input_bytes;
+    int64_t encoded_bytes;
+    //raw timings of the measured roundtrips in the order they were taken
+    std::vector<double> encode_samples;
+    std::vector<double> decode_samples;
+    //DELTA_BINARY_PACKED: number of miniblocks of the page per bit width, indexed by the width up to
+    //the bit width of the type, read from the first encoded page outside the timed phases. Empty for
+    //other encodings
+    std::vector<int64_t> bit_widths;
+
+    //median time and TSC ticks per value
+    double encode_ns_per_value() const { return encode.median/value_count; }
+    double decode_ns_per_value() const { return decode.median/value_count; }
+    double encode_cycles_per_value() const { return encode_cycles.median/value_count; }
+    double decode_cycles_per_value() const { return decode_cycles.median/value_count; }
+    //unencoded size divided by encoded size
+    double compression_ratio() const { return static_cast<double>(input_bytes)/encoded_bytes; }
+};
+
+/**
+ * @brief Whether Parquet defines the encoding for the physical type and the linked Arrow version
+ *        implements it. PLAIN_DICTIONARY and RLE_DICTIONARY both select dictionary encoding
+ */
+bool encoding_supported(parquet::Type::type type, parquet::Encoding::type encoding);
+
+/**
+ * @brief Parses an encoding name as printed by parquet::EncodingToString, e.g. "DELTA_BINARY_PACKED"
+ *
+ * @throw std::invalid_argument for unknown names
+ */
+parquet::Encoding::type parse_encoding(const std::string &name);
+
+/**
+ * @brief Executes a set amount of parquet-encoder roundtrips with the given data and encoding and
+ *        returns the statistics of the encoding and decoding times in ns. Dictionary encodings write
+ *        the dictionary page as part of the encoding and decode it as part of SetData, so their
+ *        encoded size includes the dictionary. Encoder and decoder allocate from a TrackingMemoryPool
+ *        over options.memory_pool and are created per roundtrip, or once if options.steady_state is set.
+ *        With options.decode_threads set, DELTA_BINARY_PACKED pages are decoded in parallel by the
+ *        reference decoder and Arrow's decoder is not given the page, so SetData takes no time
+ *
+ * @tparam DType parquet::Int32Type, Int64Type, FloatType, DoubleType or ByteArrayType
+ * @param options The number of warm-up and measured repetitions and the memory pool backend
+ * @param in_data The values to use for the roundtrip, not copied
+ * @param value_count The number of values in in_data
+ * @param encoding The encoding to measure
+ * @return RoundtripResult statistics of the encoding and decoding times in ns and the allocations
+ * @throw std::invalid_argument if the encoding is not supported for the type, std::runtime_error if
+ *        the first DELTA_BINARY_PACKED page of an integer column differs from the one the reference
+ *        codec writes at any supported SIMD level or the reference codec does not decode it
+ */
+template<typename DType>
+RoundtripResult encoder_roundtrip(const RoundtripOptions &options, const typename DType::c_type *in_data,
+                                  int64_t value_count, parquet::Encoding::type encoding);
+
+/**
+ * @brief Measures roundtrips of all values of the vector, see the pointer overload
+ */
+template<typename DType>
+RoundtripResult encoder_roundtrip(const RoundtripOptions &options, const std::vector<typename DType::c_type> &in_data,
+                                  parquet::Encoding::type encoding) {
+    return encoder_roundtrip<DType>(options, in_data.data(), static_cast<int64_t>(in_data.size()), encoding);
+}
+
+extern template RoundtripResult encoder_roundtrip<parquet::Int32Type>(const RoundtripOptions &, const int32_t *,
+                                                                       int64_t, parquet::Encoding::type);
+extern template RoundtripResult encoder_roundtrip<parquet::Int64Type>(const RoundtripOptions &, const int64_t *,
+                                                                       int64_t, parquet::Encoding::type);
+extern template RoundtripResult encoder_roundtrip<parquet::FloatType>(const RoundtripOptions &, const float *,
+                                                                       int64_t, parquet::Encoding::type);
+extern template RoundtripResult encoder_roundtrip<parquet::DoubleType>(const RoundtripOptions &, const double *,
+                                                                        int64_t, parquet::Encoding::type);
+extern template RoundtripResult encoder_roundtrip<parquet::ByteArrayType>(const RoundtripOptions &,
+                                                                           const parquet::ByteArray *,
+                                                                           int64_t, parquet::Encoding::type);
+
+/**
+ * @brief Measures roundtrips of an OPTIONAL column (max definition level 1) through PutSpaced and
+ *        DecodeSpaced, see encoder_roundtrip. Only the valid slots are encoded, validated and counted
+ *        in input_bytes; value_count and the per-value times count all slots
+ *
+ * @param in_data value_count slots, the values in null slots are ignored
+ * @param valid_bits Validity bitmap of the slots, LSB first, set for valid slots
+ * @throw std::invalid_argument if the encoding is not supported for the type
+ */
+template<typename DType>
+RoundtripResult encoder_spaced_roundtrip(const RoundtripOptions &options, const typename DType::c_type *in_data,
+                                         int64_t value_count, const uint8_t *valid_bits,
+                                         parquet::Encoding::type encoding);
+
+extern template RoundtripResult encoder_spaced_roundtrip<parquet::Int32Type>(const RoundtripOptions &,
+                                                                              const int32_t *, int64_t,
+                                                                              const uint8_t *,
+                                                                              parquet::Encoding::type);
+extern template RoundtripResult encoder_spaced_roundtrip<parquet::Int64Type>(const RoundtripOptions &,
+                                                                              const int64_t *, int64_t,
+                                                                              const uint8_t *,
+                                                                              parquet::Encoding::type);
+extern template RoundtripResult encoder_spaced_roundtrip<parquet::FloatType>(const RoundtripOptions &,
+                                                                              const float *, int64_t,
+                                                                              const uint8_t *,
+                                                                              parquet::Encoding::type);
+extern template RoundtripResult encoder_spaced_roundtrip<parquet::DoubleType>(const RoundtripOptions &,
+                                                                               const double *, int64_t,
+                                                                               const uint8_t *,
+                                                                               parquet::Encoding::type);
+extern template RoundtripResult encoder_spaced_roundtrip<parquet::ByteArrayType>(const RoundtripOptions &,
+                                                                                  const parquet::ByteArray *,
+                                                                                  int64_t, const uint8_t *,
+                                                                                  parquet::Encoding::type);
+
+/**
+ * @brief Measures roundtrips of an Arrow array, see encoder_roundtrip. The array is encoded with
+ *        Put(const arrow::Array &) and decoded with DecodeArrow (DecodeArrowNonNull without nulls)
+ *        into an arrow::Int64Builder allocating from the tracked pool, whose Finish is part of the
+ *        decode time. An array with nulls is written as an OPTIONAL column
+ *
+ * @param array The values, including its validity bitmap and offset
+ * @throw std::invalid_argument if the encoding is not supported for INT64,
+ *        parquet::ParquetException if the builder fails
+ */
+RoundtripResult encoder_arrow_roundtrip(const RoundtripOptions &options, const arrow::Int64Array &array,
+                                        parquet::Encoding::type encoding);
+
+/**
+ * @brief Measures roundtrips through the reference DELTA_BINARY_PACKED codec of DeltaBitPackCodec.h,
+ *        see encoder_roundtrip. Put is the encoding, FlushValues takes no time and SetData reads the
+ *        page header. The page buffer and the output are reused and nothing is allocated from a pool
+ *
+ * @tparam T int32_t or int64_t
+ * @param level The kernels to use
+ * @param unpack The unpack kernels the decoder uses
+ * @throw std::invalid_argument if the CPU does not support the level
+ */
+template<typename T>
+RoundtripResult reference_delta_roundtrip(const RoundtripOptions &options, const T *in_data, int64_t value_count,
+                                          SimdLevel level, UnpackKernel unpack = UnpackKernel::Generic);
+
+extern template RoundtripResult reference_delta_roundtrip<int32_t>(const RoundtripOptions &, const int32_t *,
+                                                                   int64_t, SimdLevel, UnpackKernel);
+extern template RoundtripResult reference_delta_roundtrip<int64_t>(const RoundtripOptions &, const int64_t *,
+                                                                   int64_t, SimdLevel, UnpackKernel);
+
 /**
- * @brief Takes a int64_t vector and measures the time it takes to encode and decode
- *        parquet format with DELTA_BINARY_PACKED encoding
- * 
- * @param sample_repeat The number of times to repeat the measurement to account for disturbances
- * @param in_data The int64_t data to use for the roundtrip
- * @return A std::pair of encoding time and decoding time as int64_t in µs
+ * @brief Prints the encoded size, the compression ratio and the memory pool activity per roundtrip
  */
-std::pair<int64_t, int64_t> encoder_roundtrip(int sample_repeat, std::vector<int64_t> &in_data);
+void print_memory_usage(std::ostream &os, const RoundtripResult &result);
 
 /**
- * @brief Takes a int32_t vector and measures the time it takes to encode and decode
- *        parquet format with DELTA_BINARY_PACKED encoding
- * 
- * @param sample_repeat The number of times to repeat the measurement to account for disturbances
- * @param in_data The int32_t data to use for the roundtrip
- * @return A std::pair of encoding time and decoding time as int64_t in µs
+ * @brief Prints the share of the miniblocks at every bit width that occurs and their mean bit width,
+ *        nothing if the result has no bit widths
  */
-std::pair<int64_t, int64_t> encoder_roundtrip(int sample_repeat, std::vector<int32_t> &in_data);
+void print_bit_widths(std::ostream &os, const RoundtripResult &result);
 
 /**
- * @brief Executes a set amout of parquet-encoder(DELTA_BINARY_PACKED encoding) roundtrips with the given data
- *        and returns the best measurement pair (sorted by encoding time) in µs
- * 
- * @param sample_repeat the number of 
- * @param in_data An int64_t vector containing the data to be used for the round trips
- * @return std::pair<int64_t, int64_t> a pair of (encode time, decode time) in µs
+ * @brief Prints the per-value hardware counters and the IPC of every phase as a table,
+ *        or a notice if no counters were read
  */
-std::pair<int64_t, int64_t> encoder_detailed_roundtrip(int sample_repeat, std::vector<int64_t> &in_data);
+void print_phase_counters(std::ostream &os, const RoundtripResult &result);
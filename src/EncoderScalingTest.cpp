@@ -1,110 +1,191 @@
 #include <iostream>
 #include <fstream>
-#include <stdexcept>
+#include <sstream>
+#include <string>
 #include <vector>
-#include <chrono>
-#include "parquet/schema.h"
-#include "parquet/encoding.h"
-#include "parquet/types.h"
+#include <array>
+#include <limits>
+#include <algorithm>
+#include <tuple>
+#include <optional>
+#include <unistd.h>
+
+#include "BenchmarkClock.h"
+#include "CorpusCache.h"
+#include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+namespace {
+
+/**
+ * @brief Reads the size of the data (or unified) cache of the given level of cpu0 in bytes
+ *        from sysfs, falling back to sysconf
+ *
+ * @param level cache level 1-3
+ * @return int64_t size in bytes or 0 if unknown
+ */
+int64_t cache_size(int level) {
+    for(int index=0; index<8; ++index) {
+        std::string base = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + '/';
+        std::ifstream levelFile(base + "level");
+        std::ifstream typeFile(base + "type");
+        std::ifstream sizeFile(base + "size");
+        int cacheLevel;
+        std::string type;
+        std::string size;
+        if(!(levelFile >> cacheLevel) || !(typeFile >> type) || !(sizeFile >> size)) break;
+        if(cacheLevel != level || type == "Instruction") continue;
+        //size is given as e.g. "48K" or "2048K"
+        int64_t bytes = std::stoll(size);
+        switch(size.back()) {
+            case 'K': bytes *= 1024; break;
+            case 'M': bytes *= 1024*1024; break;
+            case 'G': bytes *= 1024*1024*1024; break;
+        }
+        return bytes;
+    }
+    long bytes{0};
+    switch(level) {
+        case 1: bytes = sysconf(_SC_LEVEL1_DCACHE_SIZE); break;
+        case 2: bytes = sysconf(_SC_LEVEL2_CACHE_SIZE); break;
+        case 3: bytes = sysconf(_SC_LEVEL3_CACHE_SIZE); break;
+    }
+    return std::max<long>(bytes, 0);
+}
+
+/**
+ * @brief Returns the name of the smallest memory level the working set fits into
+ */
+std::string memory_level(int64_t working_set, const std::array<int64_t, 3> &caches) {
+    for(int level=0; level<3; ++level) {
+        if(caches.at(level) > 0 && working_set <= caches.at(level)) return "L" + std::to_string(level+1);
+    }
+    return "DRAM";
+}
+
+} // namespace
 
 int main(int argc, char *argv[]) {
-    if(argc != 2) {
+    if(argc > 4) {
         std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
-                    << " <Number of Values to write>\n";
+                    << " [maximum input size in MB (default 4096)] [delta (default 1000)] [corpus cache directory]\n";
         return 1;
     }
     //______________Parsing_arguments___________
     //argument parsing adapted from here https://stackoverflow.com/a/2797823
-    int64_t value_count; //value count
-    //deltas to test (fitting within different bitwidths)
-    std::array<int64_t, 11>deltas{{1, 10, 100, 500, 1000, 10000, 32000, 42000,
-                                     1000000000, 3000000000, 4000000000000000000}};
-    std::istringstream s1(argv[1]);
-    if (!(s1 >> value_count)) {
-        std::cerr << "Invalid number: " << argv[1] << '\n';
-    } else if (!s1.eof()) {
-        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+    int64_t max_mb{4096};
+    int64_t delta{1000};
+    if(argc > 1) {
+        std::istringstream s1(argv[1]);
+        if (!(s1 >> max_mb) || !s1.eof() || max_mb < 1) {
+            std::cerr << "Invalid number: " << argv[1] << '\n';
+            return 1;
+        }
+        //Put takes the value count as int
+        const int64_t limit = std::numeric_limits<int>::max()*static_cast<int64_t>(sizeof(int64_t))/1'000'000;
+        if(max_mb > limit) {
+            std::cerr << "Maximum input size " << max_mb << "MB exceeds the " << limit << "MB one page can hold\n";
+            return 1;
+        }
     }
-    //_______________Parsing_done_______________
-    std::vector<int64_t> encodeResult;
-    std::vector<int64_t> decodeResult;
-    for(int64_t delta : deltas) {
-        //fill some_data with values
-        std::vector<int64_t> in_data;
-        in_data.resize(value_count);
-        //initialize data with evenly spaced values
-        int64_t val = 0; //value that will progressively update beetween minvalue and maxvalue
-        for(auto &elem : in_data) {
-            elem = val;
-            //overflow would result in out-of-spec delta for this test so make sure to keep limits
-            if(val >= std::numeric_limits<int64_t>::max()-delta || val <= std::numeric_limits<int64_t>::min()+delta) { 
-            delta = -delta;
-            }
-            val+=delta;
+    if(argc > 2) {
+        std::istringstream s2(argv[2]);
+        if (!(s2 >> delta) || !s2.eof() || delta < 0) {
+            std::cerr << "Invalid delta: " << argv[2] << '\n';
+            return 1;
         }
+    }
+    const std::string cacheDir{argc > 3 ? argv[3] : ""};
+    //_______________Parsing_done_______________
+    std::cout << "Time stamp counter runs at " << tsc_ticks_per_ns() << "GHz, cycles are counted in its ticks\n";
+    const std::array<int64_t, 3> caches{{cache_size(1), cache_size(2), cache_size(3)}};
+    std::cout << "Detected caches: L1d " << caches.at(0)/1024 << "KiB, L2 " << caches.at(1)/1024
+                << "KiB, L3 " << caches.at(2)/1024 << "KiB\n";
 
-        //calculate throughput
-        float dataInMb = static_cast<float>(in_data.size()*sizeof(int64_t))/1'000'000;
+    //relative throughput drop compared to the previous point that gets flagged
+    constexpr float dropThreshold{0.15};
+    //sweep from 1KiB of input (L1 resident) up to max_mb, four points per doubling of the size
+    const int64_t max_count = max_mb*1'000'000/static_cast<int64_t>(sizeof(int64_t));
+    std::vector<int64_t> value_counts;
+    for(double count = 1024/sizeof(int64_t); count <= max_count; count *= 1.189207115) { // 2^(1/4)
+        int64_t rounded = static_cast<int64_t>(count);
+        if(value_counts.empty() || value_counts.back() != rounded) value_counts.push_back(rounded);
+    }
 
-        std::vector<std::pair<int64_t, int64_t>> measurements;
-    for(int i=0; i<sample_repeat; ++i) {
-        //________________start_test________________
-        auto node = parquet::schema::Int64("Test", parquet::Repetition::REQUIRED);
-        auto columnDescr = std::make_shared<parquet::ColumnDescriptor>(node, 0, 0);
+    //every point measures a prefix of one input of the largest size, so it is generated only once,
+    //or mapped from the corpus cache without generating it at all
+    WorkloadSpec spec;
+    spec.delta = delta;
+    std::vector<int64_t> generated;
+    std::optional<MappedCorpus> corpus;
+    const int64_t *in_data;
+    try {
+        if(cacheDir.empty()) {
+            generated = generate_workload<int64_t>(spec, value_counts.back());
+            in_data = generated.data();
+        } else {
+            corpus.emplace(cached_workload<int64_t>(cacheDir, spec, value_counts.back()));
+            in_data = corpus->values<int64_t>();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
 
-        auto encoder =
-            parquet::MakeTypedEncoder<parquet::Int64Type>(parquet::Encoding::DELTA_BINARY_PACKED, false, columnDescr.get());
-        auto decoder = parquet::MakeTypedDecoder<parquet::Int64Type>(parquet::Encoding::DELTA_BINARY_PACKED, columnDescr.get());
+    ResultsWriter results("EncoderScalingTest", argc, argv);
+    float lastEncMbS{0};
+    float lastDecMbS{0};
+    std::string lastLevel;
+    for(int64_t value_count : value_counts) {
+        const int64_t bytes = value_count*static_cast<int64_t>(sizeof(int64_t));
+        //input and decoded output are live at the same time, the encoded buffer is neglected
+        const std::string level = memory_level(2*bytes, caches);
+        //keep the total runtime of the large points bounded
+        const int sample_repeat = static_cast<int>(std::clamp<int64_t>(4'000'000'000/bytes, 3, 100));
 
-        std::vector<int64_t> out_data;
-        out_data.resize(in_data.size());
-        //start timing encoding
-        const auto startE = std::chrono::steady_clock::now();
-        //encode
-        encoder->Put(in_data.data(), in_data.size());
-        auto encode_buffer = encoder->FlushValues();
-        //stop timing encoding & start timeing decoding
-        const auto mid = std::chrono::steady_clock::now();
-        //decode
-        decoder->SetData(in_data.size(), encode_buffer->data(),
-                            static_cast<int>(encode_buffer->size()));
-        int values_decoded = decoder->Decode(out_data.data(), out_data.size());
-        //stop timing decoding
-        const auto endD = std::chrono::steady_clock::now();
-        //check output volume
-        if(values_decoded != in_data.size()) {
-            std::cerr << "Decoded " << values_decoded << " values but expected " << in_data.size() << " !\n";
-        }
-        //validate data
-        int error_count{0};
-        int err_output_limit{10};
-        for(int i = 0; i < in_data.size(); ++i) {
-            int64_t in{in_data.at(i)};
-            int64_t out{out_data.at(i)};
-            if(in != out) {
-                ++error_count;
-                if( err_output_limit < 0 || error_count <= err_output_limit)
-                std::cerr << "Mismatching value #" << i << "was expected to be "
-                            << in << " but was " << out << '\n';
-                if(error_count == err_output_limit) {
-                    std::cerr << "Too many mismatched values! Omitting output...\n";
-                }
-            }
+        //call test function
+        RoundtripOptions options;
+        options.sample_repeat = sample_repeat;
+        options.adaptive = true;
+        RoundtripResult result = encoder_roundtrip<parquet::Int64Type>(options, in_data, value_count,
+                                                                       parquet::Encoding::DELTA_BINARY_PACKED);
+        //median of the measured roundtrips in ns
+        double encNanoS = result.encode.median;
+        double decNanoS = result.decode.median;
+        // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+        float encMbS = encNanoS > 0 ? static_cast<float>(bytes)*1000/encNanoS : 0;
+        float decMbS = decNanoS > 0 ? static_cast<float>(bytes)*1000/decNanoS : 0;
+
+        std::cout << value_count << " values (" << static_cast<float>(bytes)/1'000'000 << "Mb, working set in "
+                    << level << ")\nEncoding took\t" << encNanoS << "ns → ~" << encMbS << "Mb/s, "
+                    << result.encode_ns_per_value() << "ns/value, " << result.encode_cycles_per_value()
+                    << "cycles/value\t[" << result.encode << "]\n"
+                    << "Decoding took\t" << decNanoS << "ns → ~" << decMbS << "Mb/s, "
+                    << result.decode_ns_per_value() << "ns/value, " << result.decode_cycles_per_value()
+                    << "cycles/value\t[" << result.decode << "]\n";
+        print_memory_usage(std::cout, result);
+        //mark the cache level transitions and how much throughput was lost crossing them
+        bool breakpoint = !lastLevel.empty() && level != lastLevel;
+        if(breakpoint) {
+            std::cout << "\t--- " << lastLevel << " → " << level << " boundary:";
+            if(lastEncMbS > 0 && encMbS > 0) std::cout << " encode " << (encMbS/lastEncMbS-1)*100 << "%";
+            if(lastDecMbS > 0 && decMbS > 0) std::cout << " decode " << (decMbS/lastDecMbS-1)*100 << "%";
+            std::cout << " ---\n";
         }
-        if(error_count == 0) {
-            //time encoding took in µs
-            auto encMicroS =
-            std::chrono::duration_cast<std::chrono::microseconds>(mid-startE).count();
-            //time decoding took in µs
-            auto decMicroS =
-            std::chrono::duration_cast<std::chrono::microseconds>(endD-mid).count();
-            //add this runs measurements to the list
-            measurements.push_back(std::make_pair(encMicroS, decMicroS));
+        if(lastEncMbS > 0 && encMbS > 0 && encMbS < lastEncMbS*(1-dropThreshold)) {
+            std::cout << "\tencode throughput drop of " << (1-encMbS/lastEncMbS)*100 << "%\n";
         }
-        else {
-            std::cerr << "Validation complete. Unsuccessful:\n"
-                        << error_count << " missmatched values!\n";
+        if(lastDecMbS > 0 && decMbS > 0 && decMbS < lastDecMbS*(1-dropThreshold)) {
+            std::cout << "\tdecode throughput drop of " << (1-decMbS/lastDecMbS)*100 << "%\n";
         }
-    }
+        ResultRecord record;
+        record.set("workload", workload_name(spec.kind)).set("delta", delta).set("type", "INT64")
+              .set("encoding", "DELTA_BINARY_PACKED").set("memory_level", level).set("level_boundary", breakpoint);
+        add_roundtrip_fields(record, result);
+        results.write(record);
+        lastEncMbS = encMbS;
+        lastDecMbS = decMbS;
+        lastLevel = level;
     }
 }
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "parquet/schema.h"
+#include "parquet/encoding.h"
+
+#include "BenchmarkClock.h"
+#include "EncoderSelectiveDecodeTest.h"
+#include "WorkloadGenerator.h"
+
+namespace {
+
+//values decoded per throwaway Decode call while skipping
+constexpr int64_t skipBatchSize{1024};
+
+/**
+ * @brief Start and length of every run of selected values, in increasing order. The gaps before the
+ *        runs are drawn uniformly from [0, 2*mean gap], where the mean gap makes the expected fraction
+ *        of selected values equal to the selectivity
+ */
+std::vector<std::pair<int64_t, int64_t>> plan_runs(int64_t value_count, const DecodeSelection &selection) {
+    std::vector<std::pair<int64_t, int64_t>> runs;
+    const double meanGap = static_cast<double>(selection.run_length)*(1-selection.selectivity)/selection.selectivity;
+    Xoshiro256 rng(selection.seed);
+    int64_t position{0};
+    while(true) {
+        if(meanGap > 0) position += static_cast<int64_t>(rng.unit()*2*meanGap + 0.5);
+        if(position >= value_count) break;
+        const int64_t length = std::min(selection.run_length, value_count-position);
+        runs.emplace_back(position, length);
+        position += length;
+    }
+    return runs;
+}
+
+/**
+ * @brief Skips values the only way a TypedDecoder allows, by decoding them into scratch
+ */
+void skip_values(parquet::TypedDecoder<parquet::Int64Type> *decoder, int64_t count, std::vector<int64_t> &scratch) {
+    while(count > 0) {
+        const int batch = static_cast<int>(std::min<int64_t>(count, static_cast<int64_t>(scratch.size())));
+        const int decoded = decoder->Decode(scratch.data(), batch);
+        if(decoded != batch) throw std::runtime_error("Decoder ran out of values while skipping");
+        count -= decoded;
+    }
+}
+
+} // namespace
+
+SelectiveDecodeResult selective_decode(const RoundtripOptions &options, const int64_t *in_data, int64_t value_count,
+                                       parquet::Encoding::type encoding, const DecodeSelection &selection) {
+    if(!encoding_supported(parquet::Type::INT64, encoding) || encoding == parquet::Encoding::PLAIN_DICTIONARY
+       || encoding == parquet::Encoding::RLE_DICTIONARY) {
+        throw std::invalid_argument("Selective decoding of " + parquet::EncodingToString(encoding)
+                                    + " INT64 pages is not supported");
+    }
+    if(selection.selectivity <= 0 || selection.selectivity > 1 || selection.run_length < 1) {
+        throw std::invalid_argument("Selectivity has to be in (0, 1] and the run length positive");
+    }
+    TrackingMemoryPool pool(backend_memory_pool(options.memory_pool));
+    auto node = parquet::schema::PrimitiveNode::Make("Test", parquet::Repetition::REQUIRED, parquet::Type::INT64);
+    auto columnDescr = std::make_shared<parquet::ColumnDescriptor>(node, 0, 0);
+    auto encoder = parquet::MakeTypedEncoder<parquet::Int64Type>(encoding, false, columnDescr.get(), &pool);
+    auto decoder = parquet::MakeTypedDecoder<parquet::Int64Type>(encoding, columnDescr.get(), &pool);
+    encoder->Put(in_data, static_cast<int>(value_count));
+    auto encode_buffer = encoder->FlushValues();
+
+    const std::vector<std::pair<int64_t, int64_t>> runs = plan_runs(value_count, selection);
+    if(runs.empty()) throw std::invalid_argument("The selection does not select any value");
+    SelectiveDecodeResult result{};
+    result.runs = static_cast<int64_t>(runs.size());
+    for(const auto &run : runs) result.selected_values += run.second;
+    //values after the last run are never decoded
+    result.skipped_values = runs.back().first+runs.back().second-result.selected_values;
+
+    std::vector<int64_t> out_data(result.selected_values);
+    std::vector<int64_t> scratch(skipBatchSize);
+    std::vector<double> samples;
+    for(int i=0; i<options.warmup+options.sample_repeat; ++i) {
+        const Timestamp start = timestamp();
+        decoder->SetData(static_cast<int>(value_count), encode_buffer->data(),
+                         static_cast<int>(encode_buffer->size()));
+        int64_t position{0};
+        int64_t written{0};
+        for(const auto &run : runs) {
+            skip_values(decoder.get(), run.first-position, scratch);
+            const int decoded = decoder->Decode(out_data.data()+written, static_cast<int>(run.second));
+            if(decoded != run.second) throw std::runtime_error("Decoder ran out of values");
+            written += decoded;
+            position = run.first+run.second;
+        }
+        const Timestamp end = timestamp();
+        //validate data
+        written = 0;
+        for(const auto &run : runs) {
+            if(!std::equal(in_data+run.first, in_data+run.first+run.second, out_data.begin()+written)) {
+                throw std::runtime_error("Run at value " + std::to_string(run.first) + " was not decoded correctly");
+            }
+            written += run.second;
+        }
+        if(i < options.warmup) continue;
+        samples.push_back(static_cast<double>(end.ns-start.ns));
+        if(options.adaptive && static_cast<int>(samples.size()) >= options.min_samples &&
+           compute_statistics(samples).relative_ci() <= options.ci_target) {
+            break;
+        }
+    }
+    result.pass = compute_statistics(samples);
+    return result;
+}
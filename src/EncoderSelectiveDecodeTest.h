@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include "parquet/types.h"
+
+#include "EncoderRoundtripTest.h"
+#include "RoundtripStatistics.h"
+
+/**
+ * @brief Which values of a page a selective decode reads
+ */
+struct DecodeSelection {
+    //fraction of the values that is read, the rest is skipped
+    double selectivity{1.0};
+    //number of consecutive values read per Decode call, also the batch size if selectivity is 1
+    int64_t run_length{1024};
+    //seed of the random gaps between the runs
+    uint64_t seed{12141802};
+};
+
+/**
+ * @brief Measurements of a selective decode, all times in ns
+ */
+struct SelectiveDecodeResult {
+    //time of one pass over the page, from SetData until the last selected value was decoded
+    SampleStatistics pass;
+    int64_t selected_values;
+    int64_t skipped_values;
+    //number of Decode calls that returned selected values
+    int64_t runs;
+
+    double ns_per_selected_value() const { return pass.median/selected_values; }
+};
+
+/**
+ * @brief Encodes the data once and measures decoding only the selected values of it: runs of
+ *        run_length values separated by random gaps whose mean gives the selectivity. The decoder
+ *        cannot seek, so every gap is skipped the way a column reader does it, by decoding into a
+ *        throwaway buffer. The selected values are validated against the input
+ *
+ * @param options The number of warm-up and measured repetitions and the memory pool backend
+ * @param in_data The int64_t data forming one page
+ * @param value_count The number of values
+ * @param encoding The encoding of the page
+ * @param selection The selectivity and run length
+ * @return SelectiveDecodeResult statistics of the pass time in ns and the number of selected values
+ * @throw std::runtime_error if a selected value was not decoded correctly
+ */
+SelectiveDecodeResult selective_decode(const RoundtripOptions &options, const int64_t *in_data, int64_t value_count,
+                                       parquet::Encoding::type encoding, const DecodeSelection &selection);
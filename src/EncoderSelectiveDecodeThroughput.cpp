@@ -0,0 +1,102 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <array>
+
+#include "EncoderSelectiveDecodeTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
+                    << " <Number of Values in the page> [delta (default 1000)]"
+                    << " [encoding ... (default DELTA_BINARY_PACKED PLAIN)]\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    int64_t delta{1000};
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count) || value_count < 1) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    if(argc > 2) {
+        std::istringstream s2(argv[2]);
+        if (!(s2 >> delta) || !s2.eof() || delta < 0) {
+            std::cerr << "Invalid delta: " << argv[2] << '\n';
+            return 1;
+        }
+    }
+    std::vector<parquet::Encoding::type> encodings;
+    for(int a=3; a<argc; ++a) {
+        try {
+            encodings.push_back(parse_encoding(argv[a]));
+        } catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+    }
+    if(encodings.empty()) encodings = {parquet::Encoding::DELTA_BINARY_PACKED, parquet::Encoding::PLAIN};
+    //_______________Parsing_done_______________
+    const std::array<double, 5> selectivities{{1.0, 0.5, 0.1, 0.01, 0.001}};
+    const std::array<int64_t, 4> runLengths{{1, 8, 128, 1024}};
+
+    WorkloadSpec spec;
+    spec.delta = delta;
+    std::vector<int64_t> in_data = generate_workload<int64_t>(spec, value_count);
+
+    RoundtripOptions options;
+    options.warmup = 3;
+    options.sample_repeat = 20;
+
+    ResultsWriter results("EncoderSelectiveDecodeThroughput", argc, argv);
+    for(auto encoding : encodings) {
+        const std::string encodingName = parquet::EncodingToString(encoding);
+        try {
+            //a single Decode call over the whole page is the reference every pattern is compared to
+            DecodeSelection full;
+            full.run_length = value_count;
+            const double fullNs = selective_decode(options, in_data.data(), value_count, encoding, full)
+                                      .ns_per_selected_value();
+            std::cout << value_count << " values with delta of " << delta << ", " << encodingName
+                        << "\nFull decode\t" << fullNs << "ns/value\n";
+            for(double selectivity : selectivities) {
+                for(int64_t runLength : runLengths) {
+                    //less than one run is expected, the random gaps decide if anything is read at all
+                    if(value_count*selectivity < runLength) continue;
+                    DecodeSelection selection;
+                    selection.selectivity = selectivity;
+                    selection.run_length = runLength;
+                    SelectiveDecodeResult result = selective_decode(options, in_data.data(), value_count,
+                                                                    encoding, selection);
+                    const double perSelected = result.ns_per_selected_value();
+                    std::cout << "Selectivity " << selectivity << ", runs of " << runLength << "\t"
+                                << perSelected << "ns/selected value (" << perSelected/fullNs
+                                << "x full decode), " << result.selected_values << " read, "
+                                << result.skipped_values << " skipped in " << result.runs << " runs\t["
+                                << result.pass << "]\n";
+                    ResultRecord record;
+                    record.set("workload", workload_name(spec.kind)).set("delta", delta).set("type", "INT64")
+                          .set("encoding", encodingName).set("value_count", value_count)
+                          .set("selectivity", selectivity).set("run_length", runLength)
+                          .set("selected_values", result.selected_values)
+                          .set("skipped_values", result.skipped_values).set("runs", result.runs)
+                          .set("ns_per_selected_value", perSelected).set("full_decode_ns_per_value", fullNs)
+                          .set("pass_ns", result.pass);
+                    results.write(record);
+                }
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+    }
+}
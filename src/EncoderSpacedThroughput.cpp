@@ -0,0 +1,120 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <utility>
+#include <array>
+
+#include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+int main(int argc, char *argv[]) {
+    if(argc < 2 || argc > 5) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
+                    << " <Number of slots> [delta (default 1000)] [mean null run length (default 0 = independent)]"
+                    << " [encoding (default DELTA_BINARY_PACKED)]\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    int64_t delta{1000};
+    double mean_null_run{0};
+    parquet::Encoding::type encoding{parquet::Encoding::DELTA_BINARY_PACKED};
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count) || value_count < 1) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    if(argc > 2) {
+        std::istringstream s2(argv[2]);
+        if (!(s2 >> delta) || !s2.eof() || delta < 0) {
+            std::cerr << "Invalid delta: " << argv[2] << '\n';
+            return 1;
+        }
+    }
+    if(argc > 3) {
+        std::istringstream s3(argv[3]);
+        if (!(s3 >> mean_null_run) || !s3.eof() || mean_null_run < 0) {
+            std::cerr << "Invalid mean null run length: " << argv[3] << '\n';
+            return 1;
+        }
+    }
+    if(argc > 4) {
+        try {
+            encoding = parse_encoding(argv[4]);
+        } catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+    }
+    //_______________Parsing_done_______________
+    const std::array<double, 6> nullFractions{{0.0, 0.01, 0.05, 0.1, 0.2, 0.3}};
+    const std::string encodingName = parquet::EncodingToString(encoding);
+
+    WorkloadSpec spec;
+    spec.delta = delta;
+    std::vector<int64_t> in_data = generate_workload<int64_t>(spec, value_count);
+
+    RoundtripOptions options;
+    options.warmup = 3;
+    options.sample_repeat = 20;
+
+    ResultsWriter results("EncoderSpacedThroughput", argc, argv);
+    for(double nullFraction : nullFractions) {
+        NullSpec nulls;
+        nulls.null_fraction = nullFraction;
+        nulls.mean_null_run = mean_null_run;
+        int64_t null_count{0};
+        std::vector<uint8_t> valid_bits = generate_validity(nulls, value_count, &null_count);
+        //the same non-null values as one dense REQUIRED column
+        std::vector<int64_t> dense_data;
+        dense_data.reserve(value_count-null_count);
+        for(int64_t i=0; i<value_count; ++i) {
+            if((valid_bits[i >> 3] >> (i & 7)) & 1) dense_data.push_back(in_data[i]);
+        }
+        const int64_t nonNull = value_count-null_count;
+        if(nonNull == 0) continue;
+
+        RoundtripResult spaced;
+        RoundtripResult dense;
+        try {
+            spaced = encoder_spaced_roundtrip<parquet::Int64Type>(options, in_data.data(), value_count,
+                                                                  valid_bits.data(), encoding);
+            dense = encoder_roundtrip<parquet::Int64Type>(options, dense_data, encoding);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+        //both per non-null value, which is all the dense column holds
+        const double spacedEncodeNs = spaced.encode.median/nonNull;
+        const double spacedDecodeNs = spaced.decode.median/nonNull;
+        const double denseEncodeNs = dense.encode.median/nonNull;
+        const double denseDecodeNs = dense.decode.median/nonNull;
+
+        std::cout << value_count << " slots with delta of " << delta << ", " << encodingName << ", "
+                    << null_count << " nulls (" << nullFraction*100 << "%, mean run " << mean_null_run << ")"
+                    << "\nPutSpaced\t" << spacedEncodeNs << "ns/value vs Put " << denseEncodeNs << "ns/value ("
+                    << spacedEncodeNs/denseEncodeNs << "x)\t[" << spaced.encode << "]\n"
+                    << "DecodeSpaced\t" << spacedDecodeNs << "ns/value vs Decode " << denseDecodeNs << "ns/value ("
+                    << spacedDecodeNs/denseDecodeNs << "x)\t[" << spaced.decode << "]\n";
+        print_memory_usage(std::cout, spaced);
+
+        //one record per path, the per-value times of both are per non-null value
+        for(const auto &run : {std::make_pair("spaced", &spaced), std::make_pair("dense", &dense)}) {
+            ResultRecord record;
+            record.set("workload", workload_name(spec.kind)).set("delta", delta).set("type", "INT64")
+                  .set("encoding", encodingName).set("path", run.first).set("null_fraction", nullFraction)
+                  .set("mean_null_run", mean_null_run).set("null_count", null_count)
+                  .set("encode_ns_per_non_null", run.second->encode.median/nonNull)
+                  .set("decode_ns_per_non_null", run.second->decode.median/nonNull);
+            add_roundtrip_fields(record, *run.second);
+            results.write(record);
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <array>
+#include <limits>
+#include <utility>
+
+#include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+int main(int argc, char *argv[]) {
+    if(argc < 2 || argc > 3) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
+                    << " <Number of Values to write> [default|system|jemalloc|mimalloc]\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count)) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    RoundtripOptions options;
+    std::string poolName{"default"};
+    if(argc > 2) {
+        poolName = argv[2];
+        try {
+            options.memory_pool = parse_memory_pool_backend(poolName);
+            backend_memory_pool(options.memory_pool);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+    }
+    //_______________Parsing_done_______________
+    ResultsWriter results("EncoderSteadyStateThroughput", argc, argv);
+    for(int64_t delta : benchmarkDeltas) {
+        //fill some_data with evenly spaced values
+        WorkloadSpec spec;
+        spec.delta = delta;
+        std::vector<int64_t> in_data = generate_workload<int64_t>(spec, value_count);
+
+        //calculate throughput
+        const float bytes = static_cast<float>(in_data.size()*sizeof(int64_t));
+
+        //fresh schema, encoder, decoder and output per roundtrip vs. everything reused
+        RoundtripOptions steadyOptions = options;
+        steadyOptions.steady_state = true;
+        RoundtripResult fresh = encoder_roundtrip<parquet::Int64Type>(options, in_data,
+                                                                      parquet::Encoding::DELTA_BINARY_PACKED);
+        RoundtripResult steady = encoder_roundtrip<parquet::Int64Type>(steadyOptions, in_data,
+                                                                       parquet::Encoding::DELTA_BINARY_PACKED);
+
+        // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+        float freshEncMbS = bytes*1000/fresh.encode.median;
+        float freshDecMbS = bytes*1000/fresh.decode.median;
+        float steadyEncMbS = bytes*1000/steady.encode.median;
+        float steadyDecMbS = bytes*1000/steady.decode.median;
+
+        std::cout << in_data.size() << " values (" << bytes/1'000'000 << "Mb) with delta of " << delta
+                    << ", " << poolName << " memory pool"
+                    << "\nFresh objects:\tencoding ~" << freshEncMbS << "Mb/s, decoding ~" << freshDecMbS << "Mb/s"
+                    << "\nSteady state:\tencoding ~" << steadyEncMbS << "Mb/s\t[" << steady.encode << "]"
+                    << "\n\t\tdecoding ~" << steadyDecMbS << "Mb/s\t[" << steady.decode << "]\n";
+        std::cout << "Fresh objects:\n";
+        print_memory_usage(std::cout, fresh);
+        std::cout << "Steady state:\n";
+        print_memory_usage(std::cout, steady);
+
+        for(const auto &run : {std::make_pair("fresh", &fresh), std::make_pair("steady", &steady)}) {
+            ResultRecord record;
+            record.set("workload", workload_name(spec.kind)).set("delta", delta).set("type", "INT64")
+                  .set("encoding", "DELTA_BINARY_PACKED").set("memory_pool", poolName).set("objects", run.first);
+            add_roundtrip_fields(record, *run.second);
+            results.write(record);
+        }
+    }
+}
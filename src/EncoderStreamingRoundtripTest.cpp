@@ -0,0 +1,127 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "parquet/schema.h"
+#include "parquet/encoding.h"
+#include "parquet/exception.h"
+#include "parquet/platform.h"
+#include "parquet/types.h"
+
+#include "BenchmarkClock.h"
+#include "EncoderStreamingRoundtripTest.h"
+#include "TrackingMemoryPool.h"
+
+StreamingRoundtripResult encoder_streaming_roundtrip(const RoundtripOptions &options, std::vector<int64_t> &in_data,
+                                                     int64_t page_size, int64_t chunk_size) {
+    if(page_size < 1 || chunk_size < 1) {
+        throw std::invalid_argument("page_size and chunk_size must be positive");
+    }
+    const int64_t value_count = static_cast<int64_t>(in_data.size());
+    StreamingRoundtripResult result{};
+    result.value_count = value_count;
+    result.input_bytes = value_count*static_cast<int64_t>(sizeof(int64_t));
+    std::vector<double> encodeLatencies;
+    std::vector<double> decodeLatencies;
+    std::vector<double> allocations;
+    std::vector<double> allocatedBytes;
+    std::vector<double> peakBytes;
+    //the pool has to outlive the encoders, decoders and buffers that allocate from it
+    TrackingMemoryPool pool(backend_memory_pool(options.memory_pool));
+    auto node = parquet::schema::Int64("Test", parquet::Repetition::REQUIRED);
+    auto columnDescr = std::make_shared<parquet::ColumnDescriptor>(node, 0, 0);
+    std::unique_ptr<parquet::Int64Encoder> encoder;
+    std::unique_ptr<parquet::Int64Decoder> decoder;
+    //decode buffer sized for the largest page so far, reused for every page
+    std::shared_ptr<arrow::ResizableBuffer> out_page;
+    auto setup = [&]() {
+        encoder = parquet::MakeTypedEncoder<parquet::Int64Type>(parquet::Encoding::DELTA_BINARY_PACKED, false,
+                                                                columnDescr.get(), &pool);
+        decoder = parquet::MakeTypedDecoder<parquet::Int64Type>(parquet::Encoding::DELTA_BINARY_PACKED,
+                                                                columnDescr.get(), &pool);
+        out_page = parquet::AllocateBuffer(&pool, 0);
+    };
+    if(options.steady_state) setup();
+    for(int i=0; i<options.warmup+options.sample_repeat; ++i) {
+        const bool measured = i >= options.warmup;
+        const int64_t allocationsBefore = pool.allocations();
+        const int64_t bytesBefore = pool.allocated_bytes();
+        pool.reset_peak();
+        //________________start_test________________
+        if(!options.steady_state) setup();
+        int64_t encodeNanoS{0};
+        int64_t decodeNanoS{0};
+        int64_t pages{0};
+        int64_t encodedBytes{0};
+        int error_count{0};
+        int64_t page_begin{0};
+        while(page_begin < value_count) {
+            //encode one page
+            int64_t page_end = page_begin;
+            const Timestamp startE = timestamp();
+            do {
+                int64_t chunk = std::min(chunk_size, value_count-page_end);
+                encoder->Put(in_data.data()+page_end, static_cast<int>(chunk));
+                page_end += chunk;
+            } while(page_end < value_count && encoder->EstimatedDataEncodedSize() < page_size);
+            auto page_buffer = encoder->FlushValues();
+            const Timestamp mid = timestamp();
+            //decode the page
+            const int page_values = static_cast<int>(page_end-page_begin);
+            const int64_t page_bytes = page_values*static_cast<int64_t>(sizeof(int64_t));
+            if(out_page->size() < page_bytes) PARQUET_THROW_NOT_OK(out_page->Resize(page_bytes, false));
+            auto *out_values = reinterpret_cast<int64_t *>(out_page->mutable_data());
+            const Timestamp startD = timestamp();
+            decoder->SetData(page_values, page_buffer->data(), static_cast<int>(page_buffer->size()));
+            int values_decoded = decoder->Decode(out_values, page_values);
+            const Timestamp endD = timestamp();
+
+            if(measured) {
+                encodeLatencies.push_back(static_cast<double>(mid.ns-startE.ns));
+                decodeLatencies.push_back(static_cast<double>(endD.ns-startD.ns));
+            }
+            encodeNanoS += mid.ns-startE.ns;
+            decodeNanoS += endD.ns-startD.ns;
+            encodedBytes += page_buffer->size();
+            ++pages;
+            //validate page
+            if(values_decoded != page_values ||
+               !std::equal(out_values, out_values+page_values, in_data.begin()+page_begin)) {
+                ++error_count;
+                std::cerr << "Page #" << pages << " with values [" << page_begin << ';' << page_end
+                            << ") did not survive the roundtrip!\n";
+            }
+            page_begin = page_end;
+        }
+        if(error_count != 0) {
+            std::cerr << "Validation complete. Unsuccessful:\n"
+                        << error_count << " mismatched pages!\n";
+            continue;
+        }
+        if(!measured) continue;
+        allocations.push_back(static_cast<double>(pool.allocations()-allocationsBefore));
+        allocatedBytes.push_back(static_cast<double>(pool.allocated_bytes()-bytesBefore));
+        peakBytes.push_back(static_cast<double>(pool.peak_bytes()));
+        result.encode_samples.push_back(static_cast<double>(encodeNanoS));
+        result.decode_samples.push_back(static_cast<double>(decodeNanoS));
+        result.page_count = pages;
+        result.encoded_bytes = encodedBytes;
+        if(options.adaptive && static_cast<int>(result.encode_samples.size()) >= options.min_samples &&
+           compute_statistics(result.encode_samples).relative_ci() <= options.ci_target &&
+           compute_statistics(result.decode_samples).relative_ci() <= options.ci_target) {
+            break;
+        }
+    }
+    if(result.encode_samples.empty()) {
+        throw std::runtime_error("No sample of the streaming roundtrip validated successfully");
+    }
+    result.encode = compute_statistics(result.encode_samples);
+    result.decode = compute_statistics(result.decode_samples);
+    result.encode_page = compute_statistics(encodeLatencies);
+    result.decode_page = compute_statistics(decodeLatencies);
+    result.allocations = compute_statistics(allocations).median;
+    result.allocated_bytes = compute_statistics(allocatedBytes).median;
+    result.peak_bytes = compute_statistics(peakBytes).median;
+    return result;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "EncoderRoundtripTest.h"
+#include "RoundtripStatistics.h"
+
+/**
+ * @brief Measurements of a streaming roundtrip, all times in ns
+ */
+struct StreamingRoundtripResult {
+    int64_t value_count;
+    int64_t input_bytes;
+    //total encoding and decoding time over all pages of one pass
+    SampleStatistics encode;
+    SampleStatistics decode;
+    //raw totals of the measured passes in the order they were taken
+    std::vector<double> encode_samples;
+    std::vector<double> decode_samples;
+    //per-page latencies collected over all measured passes
+    SampleStatistics encode_page;
+    SampleStatistics decode_page;
+    //number of pages one pass over the input produced
+    int64_t page_count;
+    //sum of the encoded page sizes of one pass in bytes
+    int64_t encoded_bytes;
+    //median number of allocations, allocated bytes and peak bytes held per measured pass by the
+    //encoder, the decoder and the page decode buffer. The input is not included, it is the same
+    //for every page size
+    double allocations;
+    double allocated_bytes;
+    double peak_bytes;
+};
+
+/**
+ * @brief Encodes the data page by page the way a column writer does: the encoder is fed chunk_size
+ *        values at a time and flushed whenever the estimated encoded size reaches page_size bytes.
+ *        Every page is decoded and validated right after it was flushed, so neither the full
+ *        encoded data nor a full output vector is kept in memory. Encoder, decoder and the page
+ *        decode buffer allocate from a TrackingMemoryPool over options.memory_pool and are created
+ *        per pass, or once if options.steady_state is set
+ *
+ * @param options The number of warm-up and measured passes, adaptive mode and the memory pool backend
+ * @param in_data The int64_t data to use for the roundtrip
+ * @param page_size The target size of an encoded page in bytes
+ * @param chunk_size The number of values passed to a single Put call
+ * @return StreamingRoundtripResult statistics of the total and per-page times and the allocations
+ * @throw std::invalid_argument if page_size or chunk_size is not positive,
+ *        std::runtime_error if no measured pass validated successfully
+ */
+StreamingRoundtripResult encoder_streaming_roundtrip(const RoundtripOptions &options, std::vector<int64_t> &in_data,
+                                                     int64_t page_size, int64_t chunk_size);
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <array>
+#include <limits>
+
+#include "EncoderStreamingRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+int main(int argc, char *argv[]) {
+    if(argc < 2 || argc > 4) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
+                    << " <Number of Values to write> [page size in bytes (default 1048576)]"
+                    << " [values per Put call (default 1024)]\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    int64_t page_size{1024*1024};
+    int64_t chunk_size{1024};
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count)) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    if(argc > 2) {
+        std::istringstream s2(argv[2]);
+        if (!(s2 >> page_size) || !s2.eof() || page_size < 1) {
+            std::cerr << "Invalid page size: " << argv[2] << '\n';
+            return 1;
+        }
+    }
+    if(argc > 3) {
+        std::istringstream s3(argv[3]);
+        if (!(s3 >> chunk_size) || !s3.eof() || chunk_size < 1) {
+            std::cerr << "Invalid number of values per Put call: " << argv[3] << '\n';
+            return 1;
+        }
+    }
+    //_______________Parsing_done_______________
+    RoundtripOptions options;
+
+    ResultsWriter results("EncoderStreamingThroughput", argc, argv);
+    for(int64_t delta : benchmarkDeltas) {
+        //fill some_data with evenly spaced values
+        WorkloadSpec spec;
+        spec.delta = delta;
+        std::vector<int64_t> in_data = generate_workload<int64_t>(spec, value_count);
+
+        //calculate throughput
+        float dataInMb = static_cast<float>(in_data.size()*sizeof(int64_t))/1'000'000;
+
+        //call test function
+        StreamingRoundtripResult result = encoder_streaming_roundtrip(options, in_data, page_size, chunk_size);
+
+        // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+        float encMbS = static_cast<float>(result.input_bytes)*1000/result.encode.median;
+        float decMbS = static_cast<float>(result.input_bytes)*1000/result.decode.median;
+
+        std::cout << in_data.size() << " values (" << dataInMb << "Mb) with delta of " << delta
+                    << " in " << result.page_count << " pages of up to " << page_size << " bytes ("
+                    << static_cast<float>(result.encoded_bytes)/1'000'000 << "Mb encoded)"
+                    << "\nEncoding took\t" << result.encode.median << "ns → ~" << encMbS << "Mb/s\t["
+                    << result.encode << "]\n\tper page [" << result.encode_page << "]\n"
+                    << "Decoding took\t" << result.decode.median << "ns → ~" << decMbS << "Mb/s\t["
+                    << result.decode << "]\n\tper page [" << result.decode_page << "]\n"
+                    << "Memory pool\t" << result.allocations << " allocations, " << result.allocated_bytes
+                    << " bytes allocated, peak " << result.peak_bytes << " bytes per pass, input excluded\n";
+
+        ResultRecord record;
+        record.set("workload", workload_name(spec.kind)).set("delta", delta).set("type", "INT64")
+              .set("encoding", "DELTA_BINARY_PACKED").set("value_count", value_count).set("page_size", page_size)
+              .set("values_per_put", chunk_size).set("page_count", result.page_count)
+              .set("input_bytes", result.input_bytes).set("encoded_bytes", result.encoded_bytes)
+              .set("encode_mbs", encMbS).set("decode_mbs", decMbS)
+              .set("encode_ns", result.encode).set("decode_ns", result.decode)
+              .set("encode_page_ns", result.encode_page).set("decode_page_ns", result.decode_page)
+              .set("allocations", result.allocations).set("allocated_bytes", result.allocated_bytes)
+              .set("peak_bytes", result.peak_bytes)
+              .set("encode_samples_ns", result.encode_samples).set("decode_samples_ns", result.decode_samples);
+        results.write(record);
+    }
+}
@@ -1,101 +1,179 @@
 #include <iostream>
-#include <fstream>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 #include <vector>
-#include "arrow/io/file.h"
-#include "parquet/api/reader.h"
+#include "parquet/types.h"
 
+#include "BenchmarkClock.h"
+#include "CorpusCache.h"
 #include "EncoderRoundtripTest.h"
+#include "ParquetColumnLoader.h"
+#include "ResultsWriter.h"
 
-int main(int argc, char *argv[]) {
-    if(argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <path/to/data.parquet>\n";
-        return EXIT_FAILURE;
-    }
-    //_______________Reading_values_____________
-    constexpr size_t readBatchSize{100}; //number of values read at a time
-    // WARNING: Reading one value at a time is bugged and gives only 0!!!
-    int errcount = 0;
-    int readTotal = 0;
-    std::vector<int64_t> data;
-    data.resize(readBatchSize);
-    //adapted from apache/arrow/cpp/examples/parquet/low_level_api/reader_writer.cc
-    try{
-        // Create a ParquetReader instance
-        std::unique_ptr<parquet::ParquetFileReader> parquet_reader =
-                parquet::ParquetFileReader::OpenFile(argv[1], false);
+/**
+ * @brief Benchmarks one column, prints its report and writes it to the results
+ *
+ * @param column The column, its values are taken from data
+ * @param data The values of the column, loaded or mapped from the corpus cache
+ * @param value_count The number of values
+ * @param parquetPath The file the column was read from
+ */
+template<typename DType>
+void benchmark_column(const LoadedColumn &column, const typename DType::c_type *data, int64_t value_count,
+                      const std::string &parquetPath, ResultsWriter &results) {
+    //calculate throughput
+    float dataInMb = static_cast<float>(value_count*sizeof(typename DType::c_type))/1'000'000;
 
-        // Get the File MetaData
-        std::shared_ptr<parquet::FileMetaData> file_metadata = parquet_reader->metadata();
+    //call test function
+    RoundtripOptions options;
+    options.perf_counters = true;
+    RoundtripResult result = encoder_roundtrip<DType>(options, data, value_count,
+                                                      parquet::Encoding::DELTA_BINARY_PACKED);
+    //median of the measured roundtrips in ns
+    double encNanoS = result.encode.median;
+    double decNanoS = result.decode.median;
+
+    // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+    float encMbS = static_cast<float>(result.input_bytes)*1000/encNanoS;
+    float decMbS = static_cast<float>(result.input_bytes)*1000/decNanoS;
 
-        // Get the number of RowGroups
-        int num_row_groups = file_metadata->num_row_groups();
-        // Get the number of Columns
-        int num_columns = file_metadata->num_columns();
-        
-        std::cout << "Data has " << num_row_groups << "row-groups and "
-                    << num_columns << " columns.\n";
+    std::cout << "\nColumn " << column.column_index << " '" << column.name << "' ("
+                << parquet::TypeToString(column.type) << "): " << value_count << " values (" << dataInMb << "Mb)"
+                << "\nEncoding took\t" << encNanoS << "ns → ~" << encMbS << "Mb/s, "
+                << result.encode_ns_per_value() << "ns/value, " << result.encode_cycles_per_value()
+                << "cycles/value\t[" << result.encode << "]\n"
+                << "Decoding took\t" << decNanoS << "ns → ~" << decMbS << "Mb/s, "
+                << result.decode_ns_per_value() << "ns/value, " << result.decode_cycles_per_value()
+                << "cycles/value\t[" << result.decode << "]\n";
+    print_memory_usage(std::cout, result);
+    print_bit_widths(std::cout, result);
+    print_phase_counters(std::cout, result);
 
-        // Iterate over all the RowGroups in the file
-        for (int r = 0; r < num_row_groups; ++r) {
-            // Get the RowGroup Reader
-            std::shared_ptr<parquet::RowGroupReader> row_group_reader =
-                parquet_reader->RowGroup(r);
+    ResultRecord record;
+    record.set("file", parquetPath).set("column", column.name).set("column_index", column.column_index)
+          .set("type", parquet::TypeToString(column.type)).set("encoding", "DELTA_BINARY_PACKED");
+    add_roundtrip_fields(record, result);
+    results.write(record);
+}
 
-            int64_t values_read = 0;
-            int64_t rows_read = 0;
-            int16_t definition_level;
-            int16_t repetition_level;
-            std::shared_ptr<parquet::ColumnReader> column_reader;
+/**
+ * @brief Path of the corpus cache file of a column: <cache directory>/<file name>.<column index>.corpus
+ */
+std::string corpus_path(const std::string &cacheDir, const std::string &parquetPath, const LoadedColumn &column) {
+    const size_t slash = parquetPath.find_last_of('/');
+    const std::string fileName = slash == std::string::npos ? parquetPath : parquetPath.substr(slash+1);
+    return cacheDir + '/' + fileName + '.' + std::to_string(column.column_index) + ".corpus";
+}
 
-            // Get the Column Reader for the Int64 column
-            column_reader = row_group_reader->Column(0);
-            parquet::Int64Reader* int64_reader =
-                static_cast<parquet::Int64Reader*>(column_reader.get());
-            while (int64_reader->HasNext()) {
-                std::array<int64_t, readBatchSize> values;
-                // The number of rows read is returned.
-                // values_read contains the number of non-null rows
-                rows_read = int64_reader->ReadBatch(readBatchSize, &definition_level, &repetition_level,
-                                                    values.data(), &values_read);
-                // add read values to data
-                for(auto val : values) {
-                    data.push_back(val);
+/**
+ * @brief Source recorded in the corpus of a column, the cache file name alone does not tell
+ *        Parquet files of the same name in different directories apart
+ */
+std::string corpus_source(const std::string &parquetPath, const LoadedColumn &column) {
+    return parquetPath + " column " + std::to_string(column.column_index) + " " + column.name;
+}
+
+int main(int argc, char *argv[]) {
+    if(argc < 2 || argc > 4) {
+        std::cerr << "Usage: " << argv[0]
+                    << " <path/to/data.parquet> [reader threads (0 = all)] [corpus cache directory]\n";
+        return EXIT_FAILURE;
+    }
+    const std::string parquetPath{argv[1]};
+    int threads{0};
+    if(argc > 2) {
+        std::istringstream s2(argv[2]);
+        if (!(s2 >> threads) || !s2.eof() || threads < 0) {
+            std::cerr << "Invalid thread count: " << argv[2] << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+    const std::string cacheDir{argc > 3 ? argv[3] : ""};
+    //_______________Reading_values_____________
+    //with a cache directory the columns are mapped from corpus files written by an earlier run,
+    //as long as all of them are at least as new as the Parquet file and were read from it
+    std::vector<LoadedColumn> columns;
+    std::vector<MappedCorpus> corpora;
+    try {
+        const Timestamp start = timestamp();
+        bool cached{false};
+        if(!cacheDir.empty()) {
+            columns = list_integer_columns(parquetPath);
+            cached = true;
+            for(const auto &column : columns) {
+                cached = cached && corpus_up_to_date(corpus_path(cacheDir, parquetPath, column), parquetPath);
+            }
+            if(cached) {
+                for(const auto &column : columns) {
+                    corpora.emplace_back(corpus_path(cacheDir, parquetPath, column));
+                    //left over from another file of the same name or with other column types
+                    cached = cached && corpora.back().type() == column.type
+                             && corpora.back().source() == corpus_source(parquetPath, column);
+                }
+                if(!cached) corpora.clear();
+            }
+        }
+        if(!cached) {
+            columns = load_integer_columns(parquetPath, threads);
+            for(const auto &column : columns) {
+                if(cacheDir.empty()) break;
+                const std::string source = corpus_source(parquetPath, column);
+                if(column.type == parquet::Type::INT32) {
+                    write_corpus(corpus_path(cacheDir, parquetPath, column), column.int32_values.data(),
+                                 column.value_count(), source);
+                } else {
+                    write_corpus(corpus_path(cacheDir, parquetPath, column), column.int64_values.data(),
+                                 column.value_count(), source);
+                }
+            }
+        }
+        const Timestamp end = timestamp();
+        int64_t bytes{0};
+        for(size_t c=0; c<columns.size(); ++c) {
+            const int64_t count = cached ? corpora.at(c).value_count() : columns.at(c).value_count();
+            bytes += count*(columns.at(c).type == parquet::Type::INT32 ? 4 : 8);
+        }
+        std::cout << (cached ? "Mapped " : "Loaded ") << columns.size() << " int32/int64 columns ("
+                    << static_cast<float>(bytes)/1'000'000 << "Mb) from " << parquetPath
+                    << (cached ? " corpus cache" : "") << " in " << (end.ns-start.ns)/1'000'000 << "ms → ~"
+                    << static_cast<float>(bytes)*1000/(end.ns-start.ns) << "Mb/s\n";
+        if(!cached) {
+            for(const auto &column : columns) {
+                if(column.null_count > 0) {
+                    std::cout << "Column '" << column.name << "': " << column.null_count << " nulls skipped\n";
                 }
-                readTotal+=values_read;
             }
         }
-
     } catch (const std::exception& e) {
         std::cerr << "Parquet read error: " << e.what() << std::endl;
         return -1;
     }
-    //check data volume
-    if(readTotal != data.size()) {
-        std::cerr << "Data volume invariant violated!\n";
+    if(columns.empty()) {
+        std::cerr << "File has no flat int32 or int64 columns\n";
         return 1;
     }
     //data recieved
-    //calculate throughput
-    float dataInMb = static_cast<float>(data.size()*sizeof(int64_t))/1'000'000;
-
-    //call test function
-    int64_t encMicroS;
-    int64_t decMicroS;
-    std::tie(encMicroS, decMicroS) = encoder_roundtrip(100, data);
-
-    // byte / µs = byte / (s/10⁶) = byte * 10⁶ / s = MB / s
-    float encMbS = static_cast<float>(data.size()*sizeof(int64_t))/encMicroS;
-    float decMbS = static_cast<float>(data.size()*sizeof(int64_t))/decMicroS;
-
-    std::cout << data.size() << " values (" << dataInMb << "Mb) from file " << argv[1]
-                << "\nEncoding took\t" << encMicroS << "µs → ~" << encMbS << "Mb/s\n"
-                << "Decoding took\t" << decMicroS << "µs → ~" << decMbS << "Mb/s\n";
-    //append testdata to file for this test
-    std::ofstream encodeDataFile("File_Encode_TestData.csv", std::ios::app);
-    std::ofstream decodeDataFile("File_Decode_TestData.csv", std::ios::app);
-    encodeDataFile << data.size() << ", " << encMbS << '\n';
-    decodeDataFile << data.size() << ", " << decMbS << '\n';
-    encodeDataFile.close();
-    decodeDataFile.close();
+    std::cout << "Time stamp counter runs at " << tsc_ticks_per_ns() << "GHz, cycles are counted in its ticks\n";
+    //one record per column
+    ResultsWriter results("EncoderTestFromFile", argc, argv);
+    for(size_t c=0; c<columns.size(); ++c) {
+        LoadedColumn &column = columns.at(c);
+        const int64_t count = corpora.empty() ? column.value_count() : corpora.at(c).value_count();
+        if(count == 0) {
+            std::cout << "\nColumn " << column.column_index << " '" << column.name << "' has no values, skipped\n";
+            continue;
+        }
+        //mapped values are passed to the roundtrip without a copy
+        if(column.type == parquet::Type::INT32) {
+            const int32_t *data = corpora.empty() ? column.int32_values.data() : corpora.at(c).values<int32_t>();
+            benchmark_column<parquet::Int32Type>(column, data, count, parquetPath, results);
+        } else {
+            const int64_t *data = corpora.empty() ? column.int64_values.data() : corpora.at(c).values<int64_t>();
+            benchmark_column<parquet::Int64Type>(column, data, count, parquetPath, results);
+        }
+        //release the column once it is measured, the roundtrips of the next column need the memory
+        std::vector<int32_t>().swap(column.int32_values);
+        std::vector<int64_t>().swap(column.int64_values);
+    }
 }
@@ -1,5 +1,5 @@
 #include <iostream>
-#include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <chrono>
@@ -7,73 +7,78 @@
 #include "parquet/encoding.h"
 #include "parquet/types.h"
 
+#include "BenchmarkClock.h"
 #include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
 
 int main(int argc, char *argv[]) {
-    if(argc != 2) {
+    if(argc < 2 || argc > 3) {
         std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
-                    << " <Number of Values to write>\n";
+                    << " <Number of Values to write> [constant|uniform|zipf|gaussian|timestamps|ids|spikes|mixed]\n";
         return 1;
     }
     //______________Parsing_arguments___________
     //argument parsing adapted from here https://stackoverflow.com/a/2797823
     int64_t value_count; //value count
-    //deltas to test (fitting within different bitwidths)
-    std::array<int64_t, 11>deltas{{1, 10, 100, 500, 1000, 10000, 32000, 42000,
-                                     1000000000, 3000000000, 4000000000000000000}};
     std::istringstream s1(argv[1]);
     if (!(s1 >> value_count)) {
         std::cerr << "Invalid number: " << argv[1] << '\n';
     } else if (!s1.eof()) {
         std::cerr << "Trailing characters after number: " << argv[1] << '\n';
     }
-    //_______________Parsing_done_______________
-    std::vector<int64_t> encodeResult;
-    std::vector<int64_t> decodeResult;
-    for(int64_t delta : deltas) {
-        //fill some_data with values
-        std::vector<int64_t> in_data;
-        in_data.resize(value_count);
-        //initialize data with evenly spaced values
-        int64_t val = 0; //value that will progressively update beetween minvalue and maxvalue
-        for(auto &elem : in_data) {
-            elem = val;
-            //overflow would result in out-of-spec delta for this test so make sure to keep limits
-            if(val >= std::numeric_limits<int64_t>::max()-delta || val <= std::numeric_limits<int64_t>::min()+delta) { 
-            delta = -delta;
-            }
-            val+=delta;
+    Workload workload{Workload::ConstantDelta};
+    if(argc > 2) {
+        try {
+            workload = parse_workload(argv[2]);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
         }
+    }
+    //_______________Parsing_done_______________
+    std::cout << "Time stamp counter runs at " << tsc_ticks_per_ns() << "GHz, cycles are counted in its ticks\n";
+    ResultsWriter results("EncoderThroughput", argc, argv);
+    for(int64_t delta : benchmarkDeltas) {
+        //fill some_data with values, evenly spaced unless another workload was requested
+        WorkloadSpec spec;
+        spec.kind = workload;
+        spec.delta = delta;
+        std::vector<int64_t> in_data = generate_workload<int64_t>(spec, value_count);
 
         //calculate throughput
         float dataInMb = static_cast<float>(in_data.size()*sizeof(int64_t))/1'000'000;
 
         //call test function
-        int64_t encMicroS;
-        int64_t decMicroS;
-        std::tie(encMicroS, decMicroS) = encoder_roundtrip(100, in_data);
+        RoundtripOptions options;
+        options.perf_counters = true;
+        RoundtripResult result = encoder_roundtrip<parquet::Int64Type>(options, in_data,
+                                                                       parquet::Encoding::DELTA_BINARY_PACKED);
+        //median of the measured roundtrips in ns
+        double encNanoS = result.encode.median;
+        double decNanoS = result.decode.median;
 
-        // byte / µs = byte / (s/10⁶) = byte * 10⁶ / s = MB / s
-        float encMbS = static_cast<float>(in_data.size()*sizeof(int64_t))/encMicroS;
-        float decMbS = static_cast<float>(in_data.size()*sizeof(int64_t))/decMicroS;
+        // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+        float encMbS = static_cast<float>(in_data.size()*sizeof(int64_t))*1000/encNanoS;
+        float decMbS = static_cast<float>(in_data.size()*sizeof(int64_t))*1000/decNanoS;
 
-        encodeResult.push_back(encMbS);
-        decodeResult.push_back(decMbS);
 
-        std::cout << in_data.size() << " values (" << dataInMb << "Mb) with delta of " << delta
-                    << "\nEncoding took\t" << encMicroS << "µs → ~" << encMbS << "Mb/s\n"
-                    << "Decoding took\t" << decMicroS << "µs → ~" << decMbS << "Mb/s\n";
-    }
+        std::cout << in_data.size() << " values (" << dataInMb << "Mb, " << workload_name(workload)
+                    << " workload) with delta of " << delta
+                    << "\nEncoding took\t" << encNanoS << "ns → ~" << encMbS << "Mb/s, "
+                    << result.encode_ns_per_value() << "ns/value, " << result.encode_cycles_per_value()
+                    << "cycles/value\t[" << result.encode << "]\n"
+                    << "Decoding took\t" << decNanoS << "ns → ~" << decMbS << "Mb/s, "
+                    << result.decode_ns_per_value() << "ns/value, " << result.decode_cycles_per_value()
+                    << "cycles/value\t[" << result.decode << "]\n";
+        print_memory_usage(std::cout, result);
+        print_bit_widths(std::cout, result);
+        print_phase_counters(std::cout, result);
 
-    std::ofstream encodeDataFile("ConstDelta_Encode_TestData.csv", std::ios::app);
-    std::ofstream decodeDataFile("ConstDelta_Decode_TestData.csv", std::ios::app);
-    // write testrun data
-    encodeDataFile << value_count;
-    decodeDataFile << value_count;
-    for(auto eResult : encodeResult) encodeDataFile << ", " << eResult;
-    for(auto dResult : decodeResult) decodeDataFile << ", " << dResult;
-    encodeDataFile << '\n';
-    decodeDataFile << '\n';
-    encodeDataFile.close();
-    decodeDataFile.close();
+        ResultRecord record;
+        record.set("workload", workload_name(workload)).set("delta", delta).set("type", "INT64")
+              .set("encoding", "DELTA_BINARY_PACKED");
+        add_roundtrip_fields(record, result);
+        results.write(record);
+    }
 }
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <array>
+#include <limits>
+#include "parquet/types.h"
+
+#include "BenchmarkClock.h"
+#include "EncoderRoundtripTest.h"
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
+/**
+ * @brief Measures every requested encoding that is supported for DType on the same data and
+ *        prints and writes one record per encoding
+ *
+ * @param in_data The values to use for the roundtrips
+ * @param encodings The encodings to compare, unsupported ones are skipped
+ * @param delta The delta the data was generated with, written to the results
+ * @param results The results to write to
+ */
+template<typename DType>
+void compare_encodings(const std::vector<typename DType::c_type> &in_data,
+                       const std::vector<parquet::Encoding::type> &encodings, int64_t delta, ResultsWriter &results) {
+    const std::string typeName = parquet::TypeToString(DType::type_num);
+    for(auto encoding : encodings) {
+        if(!encoding_supported(DType::type_num, encoding)) continue;
+        const std::string encodingName = parquet::EncodingToString(encoding);
+        RoundtripResult result = encoder_roundtrip<DType>(RoundtripOptions{}, in_data, encoding);
+
+        // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+        float encMbS = static_cast<float>(result.input_bytes)*1000/result.encode.median;
+        float decMbS = static_cast<float>(result.input_bytes)*1000/result.decode.median;
+
+        std::cout << typeName << '\t' << encodingName << "\tencoding ~" << encMbS << "Mb/s ("
+                    << result.encode_ns_per_value() << "ns/value), decoding ~" << decMbS << "Mb/s ("
+                    << result.decode_ns_per_value() << "ns/value), ratio " << result.compression_ratio() << '\n';
+
+        ResultRecord record;
+        record.set("workload", workload_name(Workload::ConstantDelta)).set("delta", delta).set("type", typeName)
+              .set("encoding", encodingName);
+        add_roundtrip_fields(record, result);
+        results.write(record);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
+                    << " <Number of Values to write> [encoding ...]\n";
+        return 1;
+    }
+    //______________Parsing_arguments___________
+    //argument parsing adapted from here https://stackoverflow.com/a/2797823
+    int64_t value_count; //value count
+    std::istringstream s1(argv[1]);
+    if (!(s1 >> value_count)) {
+        std::cerr << "Invalid number: " << argv[1] << '\n';
+        return 1;
+    } else if (!s1.eof()) {
+        std::cerr << "Trailing characters after number: " << argv[1] << '\n';
+        return 1;
+    }
+    std::vector<parquet::Encoding::type> encodings;
+    try {
+        for(int i=2; i<argc; ++i) encodings.push_back(parse_encoding(argv[i]));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    if(encodings.empty()) {
+        encodings = {parquet::Encoding::PLAIN, parquet::Encoding::RLE_DICTIONARY,
+                     parquet::Encoding::DELTA_BINARY_PACKED, parquet::Encoding::DELTA_LENGTH_BYTE_ARRAY,
+                     parquet::Encoding::DELTA_BYTE_ARRAY, parquet::Encoding::BYTE_STREAM_SPLIT};
+    }
+    //_______________Parsing_done_______________
+    std::cout << "Time stamp counter runs at " << tsc_ticks_per_ns() << "GHz, cycles are counted in its ticks\n";
+    ResultsWriter results("EncodingComparison", argc, argv);
+    for(int64_t delta : benchmarkDeltas) {
+        //fill some_data with evenly spaced values
+        WorkloadSpec spec;
+        spec.delta = delta;
+        std::vector<int64_t> in_data = generate_workload<int64_t>(spec, value_count);
+        //the same sequence in every physical type: truncated to 32 bit, as floating point and as decimal strings
+        std::vector<int32_t> int32_data(in_data.begin(), in_data.end());
+        std::vector<float> float_data(in_data.begin(), in_data.end());
+        std::vector<double> double_data(in_data.begin(), in_data.end());
+        std::vector<std::string> strings;
+        strings.reserve(in_data.size());
+        for(auto elem : in_data) strings.push_back(std::to_string(elem));
+        std::vector<parquet::ByteArray> byte_array_data;
+        byte_array_data.reserve(strings.size());
+        for(const auto &str : strings) {
+            byte_array_data.emplace_back(static_cast<uint32_t>(str.size()), reinterpret_cast<const uint8_t *>(str.data()));
+        }
+
+        std::cout << in_data.size() << " values with delta of " << delta << '\n';
+        try {
+            compare_encodings<parquet::Int32Type>(int32_data, encodings, delta, results);
+            compare_encodings<parquet::Int64Type>(in_data, encodings, delta, results);
+            compare_encodings<parquet::FloatType>(float_data, encodings, delta, results);
+            compare_encodings<parquet::DoubleType>(double_data, encodings, delta, results);
+            compare_encodings<parquet::ByteArrayType>(byte_array_data, encodings, delta, results);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+    }
+}
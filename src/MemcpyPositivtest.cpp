@@ -1,5 +1,4 @@
 #include <iostream>
-#include <fstream>
 #include <sstream>
 #include <string>
 #include <cstring>
@@ -7,6 +6,9 @@
 #include <array>
 #include <chrono>
 
+#include "ResultsWriter.h"
+#include "WorkloadGenerator.h"
+
 int main(int argc, char *argv[]) {
     if(argc != 2) {
         std::cerr << "Invalid Number of Arguments! Usage: " << argv[0]
@@ -16,9 +18,6 @@ int main(int argc, char *argv[]) {
     //______________Parsing_arguments___________
     //argument parsing adapted from here https://stackoverflow.com/a/2797823
     int64_t value_count; //value count
-    //deltas to test (fitting within different bitwidths)
-    std::array<int64_t, 11>deltas{{1, 10, 100, 500, 1000, 10000, 32000, 42000,
-                                     1000000000, 3000000000, 4000000000000000000}};
     std::istringstream s1(argv[1]);
     if (!(s1 >> value_count)) {
         std::cerr << "Invalid number: " << argv[1] << '\n';
@@ -26,21 +25,12 @@ int main(int argc, char *argv[]) {
         std::cerr << "Trailing characters after number: " << argv[1] << '\n';
     }
     //_______________Parsing_done_______________
-    std::vector<int64_t> timingResult;
-    for(int64_t delta : deltas) {
-        //fill some_data with values
-        std::vector<int64_t> in_data;
-        in_data.resize(value_count);
-        //initialize data with evenly spaced values
-        int64_t val = 0; //value that will progressively update beetween minvalue and maxvalue
-        for(auto &elem : in_data) {
-            elem = val;
-            //overflow would result in out-of-spec delta for this test so make sure to keep limits
-            if(val >= std::numeric_limits<int64_t>::max()-delta || val <= std::numeric_limits<int64_t>::min()+delta) { 
-            delta = -delta;
-            }
-            val+=delta;
-        }
+    ResultsWriter results("MemcpyPositiveTest", argc, argv);
+    for(int64_t delta : benchmarkDeltas) {
+        //fill some_data with evenly spaced values
+        WorkloadSpec spec;
+        spec.delta = delta;
+        std::vector<int64_t> in_data = generate_workload<int64_t>(spec, value_count);
 
         std::vector<int64_t> out_data;
         out_data.resize(value_count);
@@ -49,7 +39,7 @@ int main(int argc, char *argv[]) {
         float dataInMb = static_cast<float>(in_data.size()*sizeof(int64_t))/1'000'000;
 
         //call test function
-        int64_t timeMicroS;
+        int64_t timeNanoS;
 
         //TODO time memcopy
         const auto start = std::chrono::steady_clock::now();
@@ -73,27 +63,24 @@ int main(int argc, char *argv[]) {
             }
         }
         if(error_count == 0) {
-            //time encoding took in µs
-            timeMicroS =
-            std::chrono::duration_cast<std::chrono::microseconds>(end-start).count();
+            //time copying took in ns
+            timeNanoS =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count();
 
-            // byte / µs = byte / (s/10⁶) = byte * 10⁶ / s = MB / s
-            float MbS = static_cast<float>(in_data.size()*sizeof(int64_t))/timeMicroS;
-            timingResult.push_back(MbS);
+            // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+            float MbS = static_cast<float>(in_data.size()*sizeof(int64_t))*1000/timeNanoS;
 
             std::cout << in_data.size() << " values (" << dataInMb << "Mb) with delta of " << delta
-                        << "\nCopy took\t" << timeMicroS << "µs → ~" << MbS << "Mb/s\n";
+                        << "\nCopy took\t" << timeNanoS << "ns → ~" << MbS << "Mb/s\n";
+
+            ResultRecord record;
+            record.set("workload", workload_name(spec.kind)).set("delta", delta).set("type", "INT64")
+                  .set("value_count", value_count).set("copy_ns", timeNanoS).set("copy_mbs", MbS);
+            results.write(record);
         }
         else {
             std::cerr << "Validation complete. Unsuccessful:\n"
                         << error_count << " missmatched values!\n";
         }
     }
-
-    std::ofstream testDataFile("Memcopy_TestData.csv", std::ios::app);
-    // write testrun data
-    testDataFile << value_count;
-    for(auto eResult : timingResult) testDataFile << ", " << eResult;
-    testDataFile << '\n';
-    testDataFile.close();
 }
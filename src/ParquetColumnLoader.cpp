@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include "parquet/api/reader.h"
+
+#include "ParquetColumnLoader.h"
+
+namespace {
+
+/**
+ * @brief One column chunk and the range of its column it is read into
+ */
+struct ChunkTask {
+    //index into the loaded columns
+    size_t column;
+    int row_group;
+    //first slot of the chunk in the column and number of slots (values including nulls)
+    int64_t offset;
+    int64_t slots;
+    //non-null values actually read, set by the reading thread
+    int64_t values_read;
+};
+
+/**
+ * @brief Reads the chunk into out, batch by batch
+ *
+ * @return int64_t the number of non-null values read
+ */
+template<typename DType>
+int64_t read_chunk(parquet::ColumnReader &column_reader, bool nullable, int64_t slots, int64_t batch_size,
+                   typename DType::c_type *out) {
+    auto &reader = static_cast<parquet::TypedColumnReader<DType> &>(column_reader);
+    //definition levels are only needed to tell nulls apart, required columns have none
+    std::vector<int16_t> definition_levels(nullable ? static_cast<size_t>(std::min(batch_size, slots)) : 0);
+    int64_t written{0};
+    int64_t levels_read{0};
+    while(reader.HasNext() && levels_read < slots) {
+        int64_t values_read{0};
+        levels_read += reader.ReadBatch(std::min(batch_size, slots-levels_read),
+                                        nullable ? definition_levels.data() : nullptr, nullptr,
+                                        out+written, &values_read);
+        written += values_read;
+    }
+    return written;
+}
+
+/**
+ * @brief The flat int32 and int64 columns in the schema, without values
+ *
+ * @param nullable Set to whether each returned column is nullable, may be nullptr
+ */
+std::vector<LoadedColumn> integer_columns(const parquet::FileMetaData &metadata, std::vector<bool> *nullable) {
+    const parquet::SchemaDescriptor *schema = metadata.schema();
+    std::vector<LoadedColumn> columns;
+    for(int c=0; c<metadata.num_columns(); ++c) {
+        const parquet::ColumnDescriptor *descr = schema->Column(c);
+        if(descr->max_repetition_level() > 0) continue;
+        if(descr->physical_type() != parquet::Type::INT32 && descr->physical_type() != parquet::Type::INT64) continue;
+        LoadedColumn column{};
+        column.name = descr->path()->ToDotString();
+        column.column_index = c;
+        column.type = descr->physical_type();
+        columns.push_back(std::move(column));
+        if(nullable != nullptr) nullable->push_back(descr->max_definition_level() > 0);
+    }
+    return columns;
+}
+
+} // namespace
+
+std::vector<LoadedColumn> list_integer_columns(const std::string &path) {
+    std::unique_ptr<parquet::ParquetFileReader> fileReader = parquet::ParquetFileReader::OpenFile(path, true);
+    return integer_columns(*fileReader->metadata(), nullptr);
+}
+
+std::vector<LoadedColumn> load_integer_columns(const std::string &path, int threads, int64_t batch_size) {
+    std::unique_ptr<parquet::ParquetFileReader> fileReader = parquet::ParquetFileReader::OpenFile(path, true);
+    std::shared_ptr<parquet::FileMetaData> metadata = fileReader->metadata();
+    std::vector<bool> nullable;
+    std::vector<LoadedColumn> columns = integer_columns(*metadata, &nullable);
+
+    //lay out every column chunk in its column and size the columns up front
+    std::vector<ChunkTask> tasks;
+    for(size_t i=0; i<columns.size(); ++i) {
+        int64_t offset{0};
+        for(int r=0; r<metadata->num_row_groups(); ++r) {
+            const int64_t slots = metadata->RowGroup(r)->ColumnChunk(columns.at(i).column_index)->num_values();
+            tasks.push_back({i, r, offset, slots, 0});
+            offset += slots;
+        }
+        if(columns.at(i).type == parquet::Type::INT32) columns.at(i).int32_values.resize(offset);
+        else columns.at(i).int64_values.resize(offset);
+    }
+    //largest chunks first, so a big chunk is not left for the end
+    std::vector<size_t> order(tasks.size());
+    for(size_t t=0; t<order.size(); ++t) order.at(t) = t;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return tasks.at(a).slots > tasks.at(b).slots; });
+
+    if(threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+    threads = static_cast<int>(std::clamp<size_t>(threads, 1, std::max<size_t>(tasks.size(), 1)));
+    std::atomic<size_t> nextTask{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    auto worker = [&] {
+        try {
+            //every thread has its own reader on the shared metadata, the mapped file is read concurrently
+            std::unique_ptr<parquet::ParquetFileReader> reader = parquet::ParquetFileReader::OpenFile(
+                path, true, parquet::default_reader_properties(), metadata);
+            for(size_t t = nextTask++; t < order.size(); t = nextTask++) {
+                ChunkTask &task = tasks.at(order.at(t));
+                LoadedColumn &column = columns.at(task.column);
+                std::shared_ptr<parquet::ColumnReader> columnReader =
+                    reader->RowGroup(task.row_group)->Column(column.column_index);
+                if(column.type == parquet::Type::INT32) {
+                    task.values_read = read_chunk<parquet::Int32Type>(*columnReader, nullable.at(task.column),
+                                                                      task.slots, batch_size,
+                                                                      column.int32_values.data()+task.offset);
+                } else {
+                    task.values_read = read_chunk<parquet::Int64Type>(*columnReader, nullable.at(task.column),
+                                                                      task.slots, batch_size,
+                                                                      column.int64_values.data()+task.offset);
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if(!error) error = std::current_exception();
+            //let the other threads run out of tasks
+            nextTask = tasks.size();
+        }
+    };
+    std::vector<std::thread> pool;
+    for(int t=1; t<threads; ++t) pool.emplace_back(worker);
+    worker();
+    for(auto &thread : pool) thread.join();
+    if(error) std::rethrow_exception(error);
+
+    //nulls leave the tail of a chunk's slots unused, close the gaps (tasks are in column and row group order)
+    for(const ChunkTask &task : tasks) {
+        LoadedColumn &column = columns.at(task.column);
+        const int64_t destination = task.offset - column.null_count;
+        column.null_count += task.slots - task.values_read;
+        if(destination == task.offset) continue;
+        if(column.type == parquet::Type::INT32) {
+            std::memmove(column.int32_values.data()+destination, column.int32_values.data()+task.offset,
+                         task.values_read*sizeof(int32_t));
+        } else {
+            std::memmove(column.int64_values.data()+destination, column.int64_values.data()+task.offset,
+                         task.values_read*sizeof(int64_t));
+        }
+    }
+    for(auto &column : columns) {
+        const int64_t count = column.value_count()-column.null_count;
+        if(column.type == parquet::Type::INT32) column.int32_values.resize(count);
+        else column.int64_values.resize(count);
+    }
+    return columns;
+}
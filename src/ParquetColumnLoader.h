@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "parquet/types.h"
+
+/**
+ * @brief All non-null values of one int32 or int64 column of a Parquet file
+ */
+struct LoadedColumn {
+    //dotted path of the column in the schema
+    std::string name;
+    int column_index;
+    //INT32 or INT64, only the matching vector is filled
+    parquet::Type::type type;
+    std::vector<int32_t> int32_values;
+    std::vector<int64_t> int64_values;
+    //number of null slots skipped while reading
+    int64_t null_count;
+
+    int64_t value_count() const {
+        return static_cast<int64_t>(type == parquet::Type::INT32 ? int32_values.size() : int64_values.size());
+    }
+};
+
+/**
+ * @brief Lists the flat int32 and int64 columns of a Parquet file from its footer, without values
+ *
+ * @throw parquet::ParquetException if the file cannot be opened
+ */
+std::vector<LoadedColumn> list_integer_columns(const std::string &path);
+
+/**
+ * @brief Reads every flat int32 and int64 column of a Parquet file. Every (row group, column) chunk
+ *        is read by one of the threads straight into its place in the column, whose size is taken
+ *        from the row group metadata up front, in batches of up to batch_size values
+ *
+ * @param path Path to the Parquet file, which is memory mapped
+ * @param threads Number of reading threads, 0 uses all hardware threads
+ * @param batch_size Number of values requested per ReadBatch call
+ * @return std::vector<LoadedColumn> the columns in schema order
+ * @throw parquet::ParquetException or std::runtime_error if the file cannot be read
+ */
+std::vector<LoadedColumn> load_integer_columns(const std::string &path, int threads = 0,
+                                               int64_t batch_size = 1 << 20);
@@ -0,0 +1,107 @@
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "PerfCounters.h"
+
+namespace {
+
+/**
+ * @brief perf_event_attr type and config of an event
+ */
+std::pair<uint32_t, uint64_t> event_config(PerfEvent event) {
+    switch(event) {
+        case PerfEvent::Cycles:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+        case PerfEvent::Instructions:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+        case PerfEvent::L1dMisses:
+            return {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+        case PerfEvent::LlcMisses:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+        case PerfEvent::BranchMisses:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+        case PerfEvent::DtlbMisses:
+            return {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+    }
+    return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+}
+
+int perf_event_open(perf_event_attr *attr, int group_fd) {
+    //measure the calling thread on any cpu
+    return static_cast<int>(syscall(__NR_perf_event_open, attr, 0, -1, group_fd, 0));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters() : leader(-1), open_count(0) {
+    fds.fill(-1);
+    slots.fill(-1);
+    for(int e=0; e<PerfEventCount; ++e) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        std::tie(attr.type, attr.config) = event_config(static_cast<PerfEvent>(e));
+        attr.disabled = leader < 0 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        int fd = perf_event_open(&attr, leader < 0 ? -1 : fds.at(leader));
+        if(fd < 0) continue;
+        fds.at(e) = fd;
+        slots.at(e) = open_count++;
+        if(leader < 0) leader = e;
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for(int fd : fds) {
+        if(fd >= 0) close(fd);
+    }
+}
+
+void PerfCounters::start() {
+    if(!available()) return;
+    ioctl(fds.at(leader), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds.at(leader), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfReading PerfCounters::stop() {
+    PerfReading reading;
+    if(!available()) return reading;
+    ioctl(fds.at(leader), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    //layout of a group read: nr, time_enabled, time_running, value[nr]
+    std::vector<uint64_t> buffer(3+open_count);
+    ssize_t bytes = read(fds.at(leader), buffer.data(), buffer.size()*sizeof(uint64_t));
+    if(bytes < static_cast<ssize_t>(3*sizeof(uint64_t))) return reading;
+    uint64_t enabled = buffer.at(1);
+    uint64_t running = buffer.at(2);
+    //the group was never on the PMU, e.g. because other users took all counters
+    if(running == 0) return reading;
+    double scale = static_cast<double>(enabled)/running;
+    for(int e=0; e<PerfEventCount; ++e) {
+        if(slots.at(e) < 0 || slots.at(e) >= static_cast<int>(buffer.at(0))) continue;
+        reading.values.at(e) = buffer.at(3+slots.at(e))*scale;
+        reading.valid.at(e) = true;
+    }
+    return reading;
+}
+
+const char *PerfCounters::name(PerfEvent event) {
+    switch(event) {
+        case PerfEvent::Cycles: return "cycles";
+        case PerfEvent::Instructions: return "instructions";
+        case PerfEvent::L1dMisses: return "L1d-misses";
+        case PerfEvent::LlcMisses: return "LLC-misses";
+        case PerfEvent::BranchMisses: return "branch-misses";
+        case PerfEvent::DtlbMisses: return "dTLB-misses";
+    }
+    return "unknown";
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief Hardware events read by PerfCounters
+ */
+enum class PerfEvent {
+    Cycles,
+    Instructions,
+    L1dMisses,
+    LlcMisses,
+    BranchMisses,
+    DtlbMisses
+};
+constexpr int PerfEventCount{6};
+
+/**
+ * @brief Counter values of one measured interval, scaled up if the kernel had to multiplex them
+ */
+struct PerfReading {
+    std::array<double, PerfEventCount> values{};
+    //false for events that could not be opened or were never scheduled
+    std::array<bool, PerfEventCount> valid{};
+
+    double operator[](PerfEvent event) const { return values.at(static_cast<int>(event)); }
+    bool has(PerfEvent event) const { return valid.at(static_cast<int>(event)); }
+};
+
+/**
+ * @brief Group of Linux perf_event_open hardware counters for the calling thread (user space only).
+ *        Events that cannot be opened, e.g. inside containers or VMs without a virtualized PMU or
+ *        with a restrictive perf_event_paranoid, are left out; if none can be opened available()
+ *        is false and stop() returns an all-invalid reading
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    /**
+     * @brief Whether at least one event could be opened
+     */
+    bool available() const { return leader >= 0; }
+
+    /**
+     * @brief Resets and enables all counters of the group
+     */
+    void start();
+
+    /**
+     * @brief Disables the counters and reads the values counted since start()
+     */
+    PerfReading stop();
+
+    /**
+     * @brief Short name of the event, e.g. "L1d-misses"
+     */
+    static const char *name(PerfEvent event);
+
+private:
+    //file descriptor of every event, -1 if unavailable
+    std::array<int, PerfEventCount> fds;
+    //position of every open event in the group read, -1 if unavailable
+    std::array<int, PerfEventCount> slots;
+    int leader;
+    int open_count;
+};
@@ -0,0 +1,475 @@
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <sys/utsname.h>
+#include <unistd.h>
+#include "arrow/util/config.h"
+
+#include "ResultsWriter.h"
+
+//set by CMake for the library, the values the benchmarks are built with may differ
+#ifndef BENCHMARK_CXX_FLAGS
+#define BENCHMARK_CXX_FLAGS "unknown"
+#endif
+#ifndef BENCHMARK_BUILD_TYPE
+#define BENCHMARK_BUILD_TYPE "unknown"
+#endif
+
+namespace {
+
+std::string compiler_version() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#else
+    return "unknown";
+#endif
+}
+
+/**
+ * @brief The first "model name" of /proc/cpuinfo
+ */
+std::string cpu_model() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while(std::getline(cpuinfo, line)) {
+        if(line.compare(0, 10, "model name") != 0) continue;
+        const size_t colon = line.find(':');
+        if(colon == std::string::npos) break;
+        const size_t start = line.find_first_not_of(' ', colon+1);
+        return start == std::string::npos ? "" : line.substr(start);
+    }
+    return "unknown";
+}
+
+std::string csv_escape(const std::string &value) {
+    if(value.find_first_of(",\"\n\r") == std::string::npos) return value;
+    std::string escaped{"\""};
+    for(char c : value) {
+        if(c == '"') escaped += '"';
+        escaped += c;
+    }
+    return escaped + '"';
+}
+
+std::string json_string(const std::string &value) {
+    std::string escaped{"\""};
+    for(char c : value) {
+        switch(c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if(static_cast<unsigned char>(c) < 0x20) {
+                    char code[7];
+                    std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(c));
+                    escaped += code;
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped + '"';
+}
+
+/**
+ * @brief The schema version and the run metadata as the leading fields of every record
+ */
+std::vector<ResultRecord::Field> metadata_fields(const RunMetadata &run) {
+    using Kind = ResultRecord::Kind;
+    return {{"schema_version", std::to_string(resultsSchemaVersion), Kind::Number},
+            {"benchmark", run.benchmark, Kind::Text},
+            {"run_id", run.run_id, Kind::Text},
+            {"timestamp", run.timestamp, Kind::Text},
+            {"host", run.host, Kind::Text},
+            {"cpu_model", run.cpu_model, Kind::Text},
+            {"os", run.os, Kind::Text},
+            {"compiler", run.compiler, Kind::Text},
+            {"compiler_flags", run.compiler_flags, Kind::Text},
+            {"build_type", run.build_type, Kind::Text},
+            {"arrow_version", run.arrow_version, Kind::Text},
+            {"command_line", run.command_line, Kind::Text}};
+}
+
+std::string format_number(double value) {
+    std::ostringstream formatted;
+    formatted.precision(std::numeric_limits<double>::digits10);
+    formatted << value;
+    return formatted.str();
+}
+
+/**
+ * @brief Parser for the flat JSON objects ResultsWriter writes: string, number, boolean and null
+ *        values and arrays of numbers, no nested objects
+ */
+class JsonLineParser {
+public:
+    explicit JsonLineParser(const std::string &line) : text(line) {}
+
+    ResultRecord parse() {
+        ResultRecord record;
+        expect('{');
+        if(peek() == '}') {
+            ++pos;
+        } else {
+            while(true) {
+                const std::string name = parse_string();
+                expect(':');
+                parse_value(record, name);
+                const char next = peek();
+                ++pos;
+                if(next == '}') break;
+                if(next != ',') fail("expected , or }");
+            }
+        }
+        if(peek() != '\0') fail("trailing characters");
+        return record;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string &message) const {
+        throw std::runtime_error(message + " at column " + std::to_string(pos+1));
+    }
+
+    //skips whitespace, '\0' at the end of the line
+    char peek() {
+        while(pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+        return pos < text.size() ? text[pos] : '\0';
+    }
+
+    void expect(char c) {
+        if(peek() != c) fail(std::string("expected ") + c);
+        ++pos;
+    }
+
+    std::string parse_string() {
+        expect('"');
+        std::string value;
+        while(pos < text.size() && text[pos] != '"') {
+            char c = text[pos++];
+            if(c == '\\') {
+                if(pos >= text.size()) break;
+                c = text[pos++];
+                switch(c) {
+                    case 'n': c = '\n'; break;
+                    case 'r': c = '\r'; break;
+                    case 't': c = '\t'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'u': {
+                        //ResultsWriter only escapes control characters this way
+                        if(pos+4 > text.size()) fail("truncated escape");
+                        const unsigned long code = std::stoul(text.substr(pos, 4), nullptr, 16);
+                        if(code > 0x7f) fail("unsupported escape");
+                        c = static_cast<char>(code);
+                        pos += 4;
+                        break;
+                    }
+                    default: break; //'"', '\\' and '/' stand for themselves
+                }
+            }
+            value += c;
+        }
+        expect('"');
+        return value;
+    }
+
+    double parse_number() {
+        peek();
+        const char *start = text.c_str()+pos;
+        char *end = nullptr;
+        const double value = std::strtod(start, &end);
+        if(end == start) fail("expected a value");
+        pos += end-start;
+        return value;
+    }
+
+    bool consume(const char *word) {
+        const size_t length = std::strlen(word);
+        if(text.compare(pos, length, word) != 0) return false;
+        pos += length;
+        return true;
+    }
+
+    void parse_value(ResultRecord &record, const std::string &name) {
+        const char c = peek();
+        if(c == '"') {
+            record.set(name, parse_string());
+        } else if(c == '[') {
+            ++pos;
+            std::vector<double> values;
+            if(peek() == ']') {
+                ++pos;
+            } else {
+                while(true) {
+                    values.push_back(parse_number());
+                    const char next = peek();
+                    ++pos;
+                    if(next == ']') break;
+                    if(next != ',') fail("expected , or ]");
+                }
+            }
+            record.set(name, values);
+        } else if(consume("null")) {
+            record.set(name, std::numeric_limits<double>::quiet_NaN());
+        } else if(consume("true")) {
+            record.set(name, true);
+        } else if(consume("false")) {
+            record.set(name, false);
+        } else {
+            const size_t start = pos;
+            const double value = parse_number();
+            const std::string token = text.substr(start, pos-start);
+            //keeps integers exact, a double would round them
+            if(token.find_first_of(".eE") == std::string::npos) record.set(name, std::stoll(token));
+            else record.set(name, value);
+        }
+    }
+
+    const std::string &text;
+    size_t pos{0};
+};
+
+} // namespace
+
+RunMetadata collect_run_metadata(const std::string &benchmark, int argc, char *argv[]) {
+    RunMetadata run;
+    run.benchmark = benchmark;
+
+    const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm utc{};
+    gmtime_r(&now, &utc);
+    char time[32];
+    std::strftime(time, sizeof(time), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    run.timestamp = time;
+
+    char host[256] = {};
+    if(gethostname(host, sizeof(host)-1) != 0) host[0] = '\0';
+    run.host = host[0] != '\0' ? host : "unknown";
+    run.run_id = run.host + '-' + std::to_string(static_cast<int64_t>(now)) + '-' + std::to_string(getpid());
+
+    run.cpu_model = cpu_model();
+    utsname system{};
+    run.os = uname(&system) == 0 ? std::string(system.sysname) + ' ' + system.release : "unknown";
+    run.compiler = compiler_version();
+    run.compiler_flags = BENCHMARK_CXX_FLAGS;
+    run.build_type = BENCHMARK_BUILD_TYPE;
+    run.arrow_version = ARROW_VERSION_STRING;
+    for(int a=0; a<argc; ++a) {
+        if(a > 0) run.command_line += ' ';
+        run.command_line += argv[a];
+    }
+    return run;
+}
+
+ResultRecord &ResultRecord::set(const std::string &name, const std::string &value) {
+    return set_field(name, value, Kind::Text);
+}
+
+ResultRecord &ResultRecord::set(const std::string &name, const char *value) {
+    return set_field(name, value, Kind::Text);
+}
+
+ResultRecord &ResultRecord::set(const std::string &name, bool value) {
+    return set_field(name, value ? "true" : "false", Kind::Number);
+}
+
+ResultRecord &ResultRecord::set(const std::string &name, const std::vector<double> &values) {
+    std::string joined;
+    for(double value : values) {
+        if(!joined.empty()) joined += ' ';
+        //JSON has no representation for NaN or infinity
+        joined += std::isfinite(value) ? format_number(value) : "0";
+    }
+    return set_field(name, std::move(joined), Kind::Numbers);
+}
+
+ResultRecord &ResultRecord::set(const std::string &prefix, const SampleStatistics &stats) {
+    set(prefix + "_min", stats.min);
+    set(prefix + "_median", stats.median);
+    set(prefix + "_p90", stats.p90);
+    set(prefix + "_p99", stats.p99);
+    set(prefix + "_mean", stats.mean);
+    set(prefix + "_stddev", stats.stddev);
+    set(prefix + "_ci_low", stats.ci_low);
+    set(prefix + "_ci_high", stats.ci_high);
+    return set(prefix + "_samples", stats.count);
+}
+
+const ResultRecord::Field *ResultRecord::find(const std::string &name) const {
+    for(const auto &field : entries) {
+        if(field.name == name) return &field;
+    }
+    return nullptr;
+}
+
+const std::string &ResultRecord::text(const std::string &name) const {
+    const Field *field = find(name);
+    if(field == nullptr) throw std::invalid_argument("Record has no field " + name);
+    return field->value;
+}
+
+double ResultRecord::number(const std::string &name) const {
+    const Field *field = find(name);
+    if(field == nullptr || field->kind != Kind::Number) {
+        throw std::invalid_argument("Record has no numeric field " + name);
+    }
+    if(field->value.empty()) return std::numeric_limits<double>::quiet_NaN();
+    if(field->value == "true" || field->value == "false") return field->value == "true";
+    return std::stod(field->value);
+}
+
+std::vector<double> ResultRecord::numbers(const std::string &name) const {
+    const Field *field = find(name);
+    if(field == nullptr || field->kind != Kind::Numbers) {
+        throw std::invalid_argument("Record has no array field " + name);
+    }
+    std::vector<double> values;
+    std::istringstream stream(field->value);
+    double value;
+    while(stream >> value) values.push_back(value);
+    return values;
+}
+
+ResultRecord &ResultRecord::set_number(const std::string &name, double value) {
+    if(!std::isfinite(value)) return set_field(name, "", Kind::Number);
+    return set_field(name, format_number(value), Kind::Number);
+}
+
+ResultRecord &ResultRecord::set_field(const std::string &name, std::string value, Kind kind) {
+    for(auto &field : entries) {
+        if(field.name != name) continue;
+        field.value = std::move(value);
+        field.kind = kind;
+        return *this;
+    }
+    entries.push_back({name, std::move(value), kind});
+    return *this;
+}
+
+void add_roundtrip_fields(ResultRecord &record, const RoundtripResult &result) {
+    // byte / ns * 10³ = byte * 10⁹ / s / 10⁶ = MB / s
+    record.set("value_count", result.value_count)
+          .set("input_bytes", result.input_bytes)
+          .set("encoded_bytes", result.encoded_bytes)
+          .set("compression_ratio", result.compression_ratio())
+          .set("encode_mbs", static_cast<double>(result.input_bytes)*1000/result.encode.median)
+          .set("decode_mbs", static_cast<double>(result.input_bytes)*1000/result.decode.median)
+          .set("encode_ns_per_value", result.encode_ns_per_value())
+          .set("decode_ns_per_value", result.decode_ns_per_value())
+          .set("encode_cycles_per_value", result.encode_cycles_per_value())
+          .set("decode_cycles_per_value", result.decode_cycles_per_value())
+          .set("encode_ns", result.encode)
+          .set("decode_ns", result.decode)
+          .set("allocations", result.allocations)
+          .set("allocated_bytes", result.allocated_bytes)
+          .set("peak_bytes", result.peak_bytes)
+          .set("encode_samples_ns", result.encode_samples)
+          .set("decode_samples_ns", result.decode_samples);
+    //every record gets the fields, so results of several encodings share one layout: an empty
+    //array and null without bit widths
+    record.set("miniblock_bit_widths", std::vector<double>(result.bit_widths.begin(), result.bit_widths.end()))
+          .set("mean_bit_width", result.bit_widths.empty() ? std::numeric_limits<double>::quiet_NaN()
+                                                           : mean_bit_width(result.bit_widths));
+}
+
+std::vector<ResultRecord> read_results(const std::string &path) {
+    std::ifstream file(path);
+    if(!file) throw std::runtime_error("Cannot open " + path);
+    std::vector<ResultRecord> records;
+    std::string line;
+    for(int64_t lineNumber=1; std::getline(file, line); ++lineNumber) {
+        if(line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        try {
+            records.push_back(JsonLineParser(line).parse());
+        } catch (const std::exception &e) {
+            throw std::runtime_error(path + ':' + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+    return records;
+}
+
+ResultsWriter::ResultsWriter(const std::string &benchmark, int argc, char *argv[])
+    : run(collect_run_metadata(benchmark, argc, argv)) {
+    const char *directory = std::getenv("BENCHMARK_RESULTS_DIR");
+    const std::string base = std::string(directory != nullptr && directory[0] != '\0' ? directory : ".")
+                             + '/' + benchmark;
+    jsonl_path = base + ".jsonl";
+    csv_path = base + ".csv";
+    json_file.open(jsonl_path, std::ios::app);
+    if(!json_file) throw std::runtime_error("Cannot open " + jsonl_path);
+}
+
+void ResultsWriter::open_csv(const std::vector<std::string> &header) {
+    std::string headerLine;
+    for(const auto &name : header) {
+        if(!headerLine.empty()) headerLine += ',';
+        headerLine += csv_escape(name);
+    }
+    std::string existing;
+    {
+        std::ifstream previous(csv_path);
+        std::getline(previous, existing);
+    }
+    if(!existing.empty() && existing != headerLine) {
+        const std::string moved = csv_path.substr(0, csv_path.size()-4) + '.' + run.run_id + ".csv";
+        if(std::rename(csv_path.c_str(), moved.c_str()) != 0) {
+            throw std::runtime_error("Cannot move " + csv_path + " with an outdated header aside");
+        }
+        existing.clear();
+    }
+    csv_file.open(csv_path, std::ios::app);
+    if(!csv_file) throw std::runtime_error("Cannot open " + csv_path);
+    if(existing.empty()) csv_file << headerLine << '\n';
+}
+
+void ResultsWriter::write(const ResultRecord &record) {
+    std::vector<ResultRecord::Field> fields = metadata_fields(run);
+    fields.insert(fields.end(), record.fields().begin(), record.fields().end());
+    if(record_fields.empty()) {
+        for(const auto &field : record.fields()) record_fields.push_back(field.name);
+        std::vector<std::string> header;
+        for(const auto &field : fields) header.push_back(field.name);
+        open_csv(header);
+    } else {
+        bool same = record.fields().size() == record_fields.size();
+        for(size_t i=0; same && i<record_fields.size(); ++i) same = record.fields()[i].name == record_fields[i];
+        if(!same) throw std::invalid_argument("Record fields differ from the first record of " + run.benchmark);
+    }
+
+    json_file << '{';
+    for(size_t i=0; i<fields.size(); ++i) {
+        const auto &field = fields[i];
+        if(i > 0) json_file << ',';
+        json_file << json_string(field.name) << ':';
+        switch(field.kind) {
+            case ResultRecord::Kind::Text: json_file << json_string(field.value); break;
+            case ResultRecord::Kind::Number: json_file << (field.value.empty() ? "null" : field.value); break;
+            case ResultRecord::Kind::Numbers: {
+                json_file << '[';
+                for(char c : field.value) json_file << (c == ' ' ? ',' : c);
+                json_file << ']';
+                break;
+            }
+        }
+    }
+    json_file << "}\n";
+    json_file.flush();
+
+    for(size_t i=0; i<fields.size(); ++i) {
+        if(i > 0) csv_file << ',';
+        csv_file << csv_escape(fields[i].value);
+    }
+    csv_file << '\n';
+    csv_file.flush();
+}
@@ -0,0 +1,164 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "EncoderRoundtripTest.h"
+#include "RoundtripStatistics.h"
+
+/**
+ * @brief Version of the record layout written by ResultsWriter, raised whenever the metadata
+ *        columns change
+ */
+constexpr int resultsSchemaVersion{1};
+
+/**
+ * @brief Describes the run every record of a ResultsWriter belongs to
+ */
+struct RunMetadata {
+    //name of the benchmark, also the base name of the result files
+    std::string benchmark;
+    //unique per process: host, start time and process id
+    std::string run_id;
+    //start of the run in UTC, ISO 8601
+    std::string timestamp;
+    std::string host;
+    std::string cpu_model;
+    //kernel name and release
+    std::string os;
+    //compiler id and version, compile flags and build type the library was built with
+    std::string compiler;
+    std::string compiler_flags;
+    std::string build_type;
+    std::string arrow_version;
+    //all arguments including the program name, separated by spaces
+    std::string command_line;
+};
+
+/**
+ * @brief Collects the metadata of the current process
+ *
+ * @param benchmark Name of the benchmark
+ * @param argc, argv The arguments of main
+ */
+RunMetadata collect_run_metadata(const std::string &benchmark, int argc, char *argv[]);
+
+/**
+ * @brief One result as an ordered list of named fields. Fields keep the order they were first set
+ *        in, setting a field again replaces its value
+ */
+class ResultRecord {
+public:
+    enum class Kind {
+        Text,   ///< written as a JSON string
+        Number, ///< written as a JSON number, or null if the value is empty
+        Numbers ///< written as a JSON array of numbers, in CSV separated by spaces
+    };
+
+    struct Field {
+        std::string name;
+        //numbers are stored formatted, arrays separated by spaces, strings unquoted
+        std::string value;
+        Kind kind;
+    };
+
+    ResultRecord &set(const std::string &name, const std::string &value);
+    ResultRecord &set(const std::string &name, const char *value);
+    ResultRecord &set(const std::string &name, bool value);
+    ResultRecord &set(const std::string &name, const std::vector<double> &values);
+
+    template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    ResultRecord &set(const std::string &name, T value) {
+        //integers are formatted exactly, a double would round large deltas
+        if constexpr (std::is_integral<T>::value) return set_field(name, std::to_string(value), Kind::Number);
+        else return set_number(name, static_cast<double>(value));
+    }
+
+    /**
+     * @brief Sets <prefix>_min, _median, _p90, _p99, _mean, _stddev, _ci_low, _ci_high and _samples
+     */
+    ResultRecord &set(const std::string &prefix, const SampleStatistics &stats);
+
+    const std::vector<Field> &fields() const { return entries; }
+
+    /**
+     * @brief The field of that name or nullptr
+     */
+    const Field *find(const std::string &name) const;
+
+    /**
+     * @brief The value of a field as stored, as a number (NaN for null) or as an array of numbers
+     *
+     * @throw std::invalid_argument if the record has no such field or it does not hold a number
+     */
+    const std::string &text(const std::string &name) const;
+    double number(const std::string &name) const;
+    std::vector<double> numbers(const std::string &name) const;
+
+private:
+    //NaN and infinity are stored as empty values, written as null to JSON
+    ResultRecord &set_number(const std::string &name, double value);
+    ResultRecord &set_field(const std::string &name, std::string value, Kind kind);
+
+    std::vector<Field> entries;
+};
+
+/**
+ * @brief Appends the sizes, throughputs in MB/s, per-value times and cycles, time statistics in ns,
+ *        allocations and the raw encode and decode timings in ns of a roundtrip to the record
+ */
+void add_roundtrip_fields(ResultRecord &record, const RoundtripResult &result);
+
+/**
+ * @brief Reads the records of a JSON lines file written by ResultsWriter, including the metadata
+ *        fields. Empty lines are skipped
+ *
+ * @throw std::runtime_error if the file cannot be read or a line is not a flat JSON object
+ */
+std::vector<ResultRecord> read_results(const std::string &path);
+
+/**
+ * @brief Appends records to <directory>/<benchmark>.jsonl, one JSON object per line, and to
+ *        <directory>/<benchmark>.csv with a header line. Every record starts with the schema version
+ *        and the RunMetadata followed by its own fields. The directory is BENCHMARK_RESULTS_DIR if
+ *        that is set in the environment, otherwise the working directory.
+ *
+ *        The CSV columns are fixed by the first record. If an existing CSV has a different header,
+ *        it is renamed to <benchmark>.<run id>.csv before a new file is started, so a file never
+ *        mixes layouts. Records with other fields than the first one throw
+ */
+class ResultsWriter {
+public:
+    /**
+     * @throw std::runtime_error if a result file cannot be opened
+     */
+    ResultsWriter(const std::string &benchmark, int argc, char *argv[]);
+
+    ResultsWriter(const ResultsWriter &) = delete;
+    ResultsWriter &operator=(const ResultsWriter &) = delete;
+
+    /**
+     * @brief Appends the record to both files and flushes them, so an aborted run keeps its results
+     *
+     * @throw std::invalid_argument if the record has other fields than the first record written
+     */
+    void write(const ResultRecord &record);
+
+    const RunMetadata &metadata() const { return run; }
+
+    //the JSON lines file the records are appended to
+    const std::string &json_path() const { return jsonl_path; }
+
+private:
+    void open_csv(const std::vector<std::string> &header);
+
+    RunMetadata run;
+    std::string jsonl_path;
+    std::string csv_path;
+    std::ofstream json_file;
+    std::ofstream csv_file;
+    //field names of the first record, empty until it is written
+    std::vector<std::string> record_fields;
+};
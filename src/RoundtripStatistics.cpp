@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+#include "RoundtripStatistics.h"
+
+namespace {
+
+/**
+ * @brief Two-sided 95% critical value of Student's t-distribution
+ *
+ * @param df degrees of freedom (sample count - 1)
+ */
+double t_critical_95(int64_t df) {
+    static constexpr std::array<double, 30> table{{
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042}};
+    if(df < 1) return 0;
+    if(df <= static_cast<int64_t>(table.size())) return table.at(df-1);
+    if(df <= 60) return 2.000;
+    if(df <= 120) return 1.980;
+    return 1.960;
+}
+
+/**
+ * @brief Linearly interpolated percentile of sorted samples
+ */
+double percentile(const std::vector<double> &sorted, double p) {
+    double rank = p*(sorted.size()-1);
+    size_t lower = static_cast<size_t>(rank);
+    size_t upper = std::min(lower+1, sorted.size()-1);
+    return sorted.at(lower) + (rank-lower)*(sorted.at(upper)-sorted.at(lower));
+}
+
+} // namespace
+
+double SampleStatistics::relative_ci() const {
+    return mean > 0 ? (ci_high-ci_low)/2/mean : 0;
+}
+
+SampleStatistics compute_statistics(std::vector<double> samples) {
+    SampleStatistics stats{};
+    if(samples.empty()) return stats;
+    std::sort(samples.begin(), samples.end());
+    stats.count = static_cast<int64_t>(samples.size());
+    stats.min = samples.front();
+    stats.median = percentile(samples, 0.5);
+    stats.p90 = percentile(samples, 0.9);
+    stats.p99 = percentile(samples, 0.99);
+    stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0)/stats.count;
+    double squares{0};
+    for(double sample : samples) squares += (sample-stats.mean)*(sample-stats.mean);
+    stats.stddev = stats.count > 1 ? std::sqrt(squares/(stats.count-1)) : 0;
+    double halfWidth = t_critical_95(stats.count-1)*stats.stddev/std::sqrt(static_cast<double>(stats.count));
+    stats.ci_low = stats.mean-halfWidth;
+    stats.ci_high = stats.mean+halfWidth;
+    return stats;
+}
+
+double mann_whitney_greater_p(const std::vector<double> &a, const std::vector<double> &b) {
+    if(a.empty() || b.empty()) return 1;
+    //pool both sides, remembering which one every sample came from
+    std::vector<std::pair<double, bool>> pooled;
+    pooled.reserve(a.size()+b.size());
+    for(double sample : a) pooled.emplace_back(sample, true);
+    for(double sample : b) pooled.emplace_back(sample, false);
+    std::sort(pooled.begin(), pooled.end());
+    const double n = static_cast<double>(pooled.size());
+    double rankSumA{0};
+    double tieTerm{0};
+    for(size_t i=0; i<pooled.size();) {
+        size_t j = i;
+        while(j < pooled.size() && pooled.at(j).first == pooled.at(i).first) ++j;
+        //tied samples share the average of their ranks, which start at 1
+        const double rank = (static_cast<double>(i+1)+static_cast<double>(j))/2;
+        for(size_t k=i; k<j; ++k) {
+            if(pooled.at(k).second) rankSumA += rank;
+        }
+        const double ties = static_cast<double>(j-i);
+        tieTerm += ties*ties*ties-ties;
+        i = j;
+    }
+    const double na = static_cast<double>(a.size());
+    const double nb = static_cast<double>(b.size());
+    const double u = rankSumA-na*(na+1)/2;
+    const double variance = na*nb/12*((n+1)-tieTerm/(n*(n-1)));
+    if(variance <= 0) return 1;
+    const double z = (u-na*nb/2-0.5)/std::sqrt(variance);
+    return 0.5*std::erfc(z/std::sqrt(2.0));
+}
+
+std::ostream &operator<<(std::ostream &os, const SampleStatistics &stats) {
+    return os << "min " << stats.min << " | median " << stats.median << " | p90 " << stats.p90
+              << " | p99 " << stats.p99 << " | mean " << stats.mean << " ± " << (stats.ci_high-stats.ci_low)/2
+              << " (σ " << stats.stddev << ", n=" << stats.count << ')';
+}
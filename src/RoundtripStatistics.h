@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief Summary of a set of timing samples, in the unit of the samples
+ */
+struct SampleStatistics {
+    int64_t count;
+    double min;
+    double median;
+    double p90;
+    double p99;
+    double mean;
+    double stddev;
+    //95% confidence interval of the mean
+    double ci_low;
+    double ci_high;
+
+    /**
+     * @brief Half the width of the confidence interval relative to the mean
+     */
+    double relative_ci() const;
+};
+
+/**
+ * @brief Computes min, median, p90, p99, mean, standard deviation and the 95% confidence
+ *        interval of the mean (Student's t) of the given samples
+ *
+ * @param samples The measured values, may be in any order
+ * @return SampleStatistics all zero if samples is empty
+ */
+SampleStatistics compute_statistics(std::vector<double> samples);
+
+/**
+ * @brief One-sided Mann-Whitney U test of whether the samples of a tend to be larger than those of b,
+ *        e.g. whether a set of timings got slower. Uses the normal approximation with tie and
+ *        continuity correction, which is accurate from about 10 samples per side
+ *
+ * @return double the p-value, 1 if either side is empty or all samples are equal
+ */
+double mann_whitney_greater_p(const std::vector<double> &a, const std::vector<double> &b);
+
+/**
+ * @brief Prints the statistics in a compact single-line form, e.g.
+ *        "min 10 | median 11 | p90 12 | p99 15 | mean 11.2 ± 0.3 (σ 1.1, n=100)"
+ */
+std::ostream &operator<<(std::ostream &os, const SampleStatistics &stats);
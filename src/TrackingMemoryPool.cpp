@@ -0,0 +1,86 @@
+#include <stdexcept>
+
+#include "TrackingMemoryPool.h"
+
+arrow::MemoryPool *backend_memory_pool(MemoryPoolBackend backend) {
+    arrow::MemoryPool *pool{nullptr};
+    arrow::Status status;
+    switch(backend) {
+        case MemoryPoolBackend::Default: return arrow::default_memory_pool();
+        case MemoryPoolBackend::System: return arrow::system_memory_pool();
+        case MemoryPoolBackend::Jemalloc: status = arrow::jemalloc_memory_pool(&pool); break;
+        case MemoryPoolBackend::Mimalloc: status = arrow::mimalloc_memory_pool(&pool); break;
+    }
+    if(!status.ok() || pool == nullptr) {
+        throw std::runtime_error("Memory pool not available in this Arrow build: " + status.ToString());
+    }
+    return pool;
+}
+
+MemoryPoolBackend parse_memory_pool_backend(const std::string &name) {
+    if(name == "default") return MemoryPoolBackend::Default;
+    if(name == "system") return MemoryPoolBackend::System;
+    if(name == "jemalloc") return MemoryPoolBackend::Jemalloc;
+    if(name == "mimalloc") return MemoryPoolBackend::Mimalloc;
+    throw std::invalid_argument("Unknown memory pool: " + name + " (expected default, system, jemalloc or mimalloc)");
+}
+
+TrackingMemoryPool::TrackingMemoryPool(arrow::MemoryPool *backend)
+    : backend(backend), allocation_count(0), total_bytes(0), current_bytes(0), peak(0) {}
+
+void TrackingMemoryPool::add_bytes(int64_t bytes) {
+    int64_t now = current_bytes.fetch_add(bytes) + bytes;
+    int64_t previous = peak.load();
+    while(now > previous && !peak.compare_exchange_weak(previous, now)) {}
+}
+
+arrow::Status TrackingMemoryPool::Allocate(int64_t size, int64_t alignment, uint8_t **out) {
+    arrow::Status status = backend->Allocate(size, alignment, out);
+    if(status.ok()) {
+        ++allocation_count;
+        total_bytes += size;
+        add_bytes(size);
+    }
+    return status;
+}
+
+arrow::Status TrackingMemoryPool::Reallocate(int64_t old_size, int64_t new_size, int64_t alignment, uint8_t **ptr) {
+    arrow::Status status = backend->Reallocate(old_size, new_size, alignment, ptr);
+    if(status.ok()) {
+        ++allocation_count;
+        if(new_size > old_size) total_bytes += new_size-old_size;
+        add_bytes(new_size-old_size);
+    }
+    return status;
+}
+
+void TrackingMemoryPool::Free(uint8_t *buffer, int64_t size, int64_t alignment) {
+    backend->Free(buffer, size, alignment);
+    current_bytes -= size;
+}
+
+void TrackingMemoryPool::ReleaseUnused() {
+    backend->ReleaseUnused();
+}
+
+int64_t TrackingMemoryPool::bytes_allocated() const {
+    return current_bytes.load();
+}
+
+int64_t TrackingMemoryPool::max_memory() const {
+    return peak.load();
+}
+
+#if ARROW_VERSION_MAJOR >= 13
+int64_t TrackingMemoryPool::total_bytes_allocated() const {
+    return total_bytes.load();
+}
+
+int64_t TrackingMemoryPool::num_allocations() const {
+    return allocation_count.load();
+}
+#endif
+
+std::string TrackingMemoryPool::backend_name() const {
+    return backend->backend_name();
+}
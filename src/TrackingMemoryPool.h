@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "arrow/memory_pool.h"
+#include "arrow/util/config.h"
+
+/**
+ * @brief Allocator behind the arrow::MemoryPool that encoders and decoders allocate from
+ */
+enum class MemoryPoolBackend {
+    Default,  ///< arrow::default_memory_pool(), depends on how Arrow was built and ARROW_DEFAULT_MEMORY_POOL
+    System,   ///< malloc/free
+    Jemalloc, ///< only if Arrow was built with jemalloc
+    Mimalloc  ///< only if Arrow was built with mimalloc
+};
+
+/**
+ * @brief Returns the Arrow memory pool of the given backend
+ *
+ * @throw std::runtime_error if Arrow was built without that allocator
+ */
+arrow::MemoryPool *backend_memory_pool(MemoryPoolBackend backend);
+
+/**
+ * @brief Parses "default", "system", "jemalloc" or "mimalloc"
+ *
+ * @throw std::invalid_argument for any other name
+ */
+MemoryPoolBackend parse_memory_pool_backend(const std::string &name);
+
+/**
+ * @brief arrow::MemoryPool that forwards to another pool and counts the allocations, the allocated
+ *        bytes and the peak number of bytes held. Counters are atomic, so the pool may be shared
+ *        between threads
+ */
+class TrackingMemoryPool : public arrow::MemoryPool {
+public:
+    explicit TrackingMemoryPool(arrow::MemoryPool *backend);
+
+    using arrow::MemoryPool::Allocate;
+    using arrow::MemoryPool::Reallocate;
+    using arrow::MemoryPool::Free;
+
+    arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t **out) override;
+    arrow::Status Reallocate(int64_t old_size, int64_t new_size, int64_t alignment, uint8_t **ptr) override;
+    void Free(uint8_t *buffer, int64_t size, int64_t alignment) override;
+    void ReleaseUnused() override;
+    int64_t bytes_allocated() const override;
+    int64_t max_memory() const override;
+#if ARROW_VERSION_MAJOR >= 13
+    int64_t total_bytes_allocated() const override;
+    int64_t num_allocations() const override;
+#endif
+    std::string backend_name() const override;
+
+    /**
+     * @brief Number of Allocate and Reallocate calls since construction
+     */
+    int64_t allocations() const { return allocation_count.load(); }
+
+    /**
+     * @brief Bytes requested by Allocate plus the growth requested by Reallocate since construction
+     */
+    int64_t allocated_bytes() const { return total_bytes.load(); }
+
+    /**
+     * @brief Highest number of bytes held at once since construction or the last reset_peak()
+     */
+    int64_t peak_bytes() const { return peak.load(); }
+
+    /**
+     * @brief Lets the peak start over from the bytes currently held
+     */
+    void reset_peak() { peak.store(current_bytes.load()); }
+
+private:
+    void add_bytes(int64_t bytes);
+
+    arrow::MemoryPool *backend;
+    std::atomic<int64_t> allocation_count;
+    std::atomic<int64_t> total_bytes;
+    std::atomic<int64_t> current_bytes;
+    std::atomic<int64_t> peak;
+};
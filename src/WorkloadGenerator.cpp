@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#include "WorkloadGenerator.h"
+#include "DeltaBitPackCodec.h"
+
+namespace {
+
+//values generated with one generator, a multiple of the miniblocks of MixedBitwidth
+constexpr int64_t chunkSize{1 << 16};
+
+using Wide = __int128;
+
+/**
+ * @brief Deltas of the Workload kinds. A source is created per chunk, so its state (e.g. the
+ *        current bit width) never depends on how the chunks are spread over the threads
+ */
+struct ConstantSource {
+    int64_t delta;
+    int64_t operator()(Xoshiro256 &, int64_t) { return delta; }
+};
+
+struct UniformSource {
+    uint64_t bound;
+    int64_t operator()(Xoshiro256 &rng, int64_t) { return static_cast<int64_t>(rng.below_or_equal(bound)); }
+};
+
+/**
+ * @brief Inverts the CDF of the continuous density x^-s on [1, n+1), which approximates the discrete
+ *        Zipf distribution closely enough for generating deltas and needs no tables
+ */
+struct ZipfSource {
+    double n;
+    double s;
+    int64_t operator()(Xoshiro256 &rng, int64_t) {
+        const double u = rng.unit();
+        double x;
+        if(std::abs(s-1) < 1e-9) {
+            x = std::pow(n+1, u);
+        } else {
+            x = std::pow((std::pow(n+1, 1-s)-1)*u + 1, 1/(1-s));
+        }
+        return std::clamp(static_cast<int64_t>(x), int64_t{1}, static_cast<int64_t>(n));
+    }
+};
+
+/**
+ * @brief Box-Muller transform, the second normal value of every pair is kept for the next call
+ */
+struct GaussianSource {
+    static constexpr double twoPi{6.283185307179586};
+    double stddev;
+    bool cached{false};
+    double next{0};
+    //the tails of a wide deviation (e.g. 4e18) leave the int64 range, where llround is undefined
+    static int64_t round(double value) {
+        constexpr double lowest{-9223372036854775808.0};
+        const double highest = std::nextafter(-lowest, 0.0);
+        return std::llround(std::clamp(value, lowest, highest));
+    }
+    int64_t operator()(Xoshiro256 &rng, int64_t) {
+        if(cached) {
+            cached = false;
+            return round(next*stddev);
+        }
+        const double radius = std::sqrt(-2*std::log(1-rng.unit()));
+        const double angle = twoPi*rng.unit();
+        next = radius*std::sin(angle);
+        cached = true;
+        return round(radius*std::cos(angle)*stddev);
+    }
+};
+
+struct JitterSource {
+    int64_t delta;
+    int64_t jitter;
+    int64_t operator()(Xoshiro256 &rng, int64_t) {
+        return delta + static_cast<int64_t>(rng.below_or_equal(2*static_cast<uint64_t>(jitter))) - jitter;
+    }
+};
+
+struct GapSource {
+    int64_t max_gap;
+    double probability;
+    int64_t operator()(Xoshiro256 &rng, int64_t) {
+        if(max_gap < 2 || rng.unit() >= probability) return 1;
+        return 2 + static_cast<int64_t>(rng.below_or_equal(max_gap-2));
+    }
+};
+
+struct MixedBitwidthSource {
+    int max_width;
+    //deltas per DELTA_BINARY_PACKED miniblock of the generated type
+    int64_t run;
+    uint64_t mask{0};
+    int64_t operator()(Xoshiro256 &rng, int64_t index) {
+        //max_width is at most 63, the width of a positive int64_t
+        if(index % run == 0) mask = (uint64_t{1} << rng.below_or_equal(max_width))-1;
+        return static_cast<int64_t>(rng.next() & mask);
+    }
+};
+
+int bit_width(uint64_t value) {
+    int width{0};
+    while(value != 0) {
+        ++width;
+        value >>= 1;
+    }
+    return width;
+}
+
+/**
+ * @brief Calls fn with the delta source of the workload for values of type T, so the chunk loops
+ *        are compiled per source
+ */
+template<typename T, typename Fn>
+void with_delta_source(const WorkloadSpec &spec, Fn fn) {
+    const int64_t delta = spec.delta < 0 ? -spec.delta : spec.delta;
+    switch(spec.kind) {
+        case Workload::ConstantDelta:
+        case Workload::OutlierSpikes:
+            fn([&] { return ConstantSource{delta}; });
+            break;
+        case Workload::UniformDelta:
+            fn([&] { return UniformSource{static_cast<uint64_t>(delta)}; });
+            break;
+        case Workload::ZipfDelta:
+            fn([&] { return ZipfSource{static_cast<double>(std::max<int64_t>(delta, 1)), spec.zipf_exponent}; });
+            break;
+        case Workload::GaussianDelta:
+            fn([&] { return GaussianSource{static_cast<double>(delta)}; });
+            break;
+        case Workload::Timestamps: {
+            const int64_t jitter = spec.jitter > 0 ? std::min(spec.jitter, delta) : delta/10;
+            fn([&] { return JitterSource{delta, jitter}; });
+            break;
+        }
+        case Workload::MonotonicIds:
+            fn([&] { return GapSource{delta, spec.gap_probability}; });
+            break;
+        case Workload::MixedBitwidth:
+            fn([&] {
+                return MixedBitwidthSource{bit_width(static_cast<uint64_t>(delta)),
+                                           deltaBlockSize<T>/deltaMiniblocksPerBlock};
+            });
+            break;
+    }
+}
+
+/**
+ * @brief Runs fn(chunk) for every chunk, distributed dynamically over the threads
+ */
+template<typename Fn>
+void parallel_for_chunks(int64_t chunk_count, int threads, Fn fn) {
+    std::atomic<int64_t> next_chunk{0};
+    auto worker = [&] {
+        for(int64_t chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++) fn(chunk);
+    };
+    std::vector<std::thread> pool;
+    for(int t=1; t<threads; ++t) pool.emplace_back(worker);
+    worker();
+    for(auto &thread : pool) thread.join();
+}
+
+/**
+ * @brief Position of a running sum on the reflected range of T: positions in [0, range] map to
+ *        lo+position, positions in (range, 2*range) to the way back down
+ */
+template<typename T>
+class Reflection {
+public:
+    Reflection() : lo(std::numeric_limits<T>::min()),
+                   range(static_cast<Wide>(std::numeric_limits<T>::max())-std::numeric_limits<T>::min()),
+                   period(2*range), position(0) {}
+
+    void start_at(Wide offset) {
+        position = offset % period;
+        if(position < 0) position += period;
+    }
+
+    T value() const { return static_cast<T>(lo + (position <= range ? position : period-position)); }
+
+    void add(int64_t delta) {
+        Wide step = delta;
+        if(step >= period || step <= -period) step %= period;
+        position += step;
+        if(position >= period) position -= period;
+        else if(position < 0) position += period;
+    }
+
+private:
+    Wide lo;
+    Wide range;
+    Wide period;
+    Wide position;
+};
+
+} // namespace
+
+Workload parse_workload(const std::string &name) {
+    for(Workload workload : allWorkloads) {
+        if(name == workload_name(workload)) return workload;
+    }
+    throw std::invalid_argument("Unknown workload: " + name + " (expected constant, uniform, zipf, gaussian, "
+                                "timestamps, ids, spikes or mixed)");
+}
+
+const char *workload_name(Workload workload) {
+    switch(workload) {
+        case Workload::ConstantDelta: return "constant";
+        case Workload::UniformDelta: return "uniform";
+        case Workload::ZipfDelta: return "zipf";
+        case Workload::GaussianDelta: return "gaussian";
+        case Workload::Timestamps: return "timestamps";
+        case Workload::MonotonicIds: return "ids";
+        case Workload::OutlierSpikes: return "spikes";
+        case Workload::MixedBitwidth: return "mixed";
+    }
+    return "unknown";
+}
+
+template<typename T>
+std::vector<T> generate_workload(const WorkloadSpec &spec, int64_t value_count) {
+    std::vector<T> values(value_count);
+    if(value_count == 0) return values;
+    const int64_t chunkCount = (value_count+chunkSize-1)/chunkSize;
+    int threads = spec.threads > 0 ? spec.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threads = static_cast<int>(std::clamp<int64_t>(threads, 1, chunkCount));
+    const Wide start = spec.kind == Workload::Timestamps ? spec.timestamp_start : 0;
+    auto chunk_seed = [&](int64_t chunk) { return spec.seed ^ SplitMix64(static_cast<uint64_t>(chunk)).next(); };
+
+    with_delta_source<T>(spec, [&](auto make_source) {
+        //pass 1: sum of the deltas of every chunk, the values are not stored
+        std::vector<Wide> offsets(chunkCount+1, 0);
+        parallel_for_chunks(chunkCount, threads, [&](int64_t chunk) {
+            Xoshiro256 rng(chunk_seed(chunk));
+            auto source = make_source();
+            const int64_t end = std::min(value_count, (chunk+1)*chunkSize);
+            Wide sum{0};
+            for(int64_t i=chunk*chunkSize; i<end; ++i) sum += source(rng, i);
+            offsets.at(chunk+1) = sum;
+        });
+        //the first value of every chunk is the start plus the deltas of all previous chunks
+        offsets.at(0) = start-std::numeric_limits<T>::min();
+        for(int64_t chunk=1; chunk<=chunkCount; ++chunk) offsets.at(chunk) += offsets.at(chunk-1);
+        //pass 2: the same deltas again, now summed up from the chunk offset
+        parallel_for_chunks(chunkCount, threads, [&](int64_t chunk) {
+            Xoshiro256 rng(chunk_seed(chunk));
+            auto source = make_source();
+            Reflection<T> position;
+            position.start_at(offsets.at(chunk));
+            const int64_t end = std::min(value_count, (chunk+1)*chunkSize);
+            for(int64_t i=chunk*chunkSize; i<end; ++i) {
+                values[i] = position.value();
+                position.add(source(rng, i));
+            }
+        });
+    });
+
+    if(spec.kind == Workload::OutlierSpikes && spec.spike_interval > 0) {
+        using U = typename std::make_unsigned<T>::type;
+        for(int64_t i=spec.spike_interval-1; i<value_count; i+=spec.spike_interval) {
+            //wraps around instead of overflowing, an outlier either way
+            values[i] = static_cast<T>(static_cast<U>(values[i]) + static_cast<U>(spec.spike_magnitude));
+        }
+    }
+    return values;
+}
+
+template std::vector<int32_t> generate_workload<int32_t>(const WorkloadSpec &, int64_t);
+template std::vector<int64_t> generate_workload<int64_t>(const WorkloadSpec &, int64_t);
+
+std::vector<uint8_t> generate_validity(const NullSpec &spec, int64_t value_count, int64_t *null_count) {
+    std::vector<uint8_t> bitmap((value_count+7)/8, 0);
+    const double p = std::min(std::max(spec.null_fraction, 0.0), 1.0);
+    Xoshiro256 rng(spec.seed);
+    //probabilities of a null after a valid slot and of a valid slot after a null
+    double toNull{p};
+    double toValid{1-p};
+    if(spec.mean_null_run > 0 && p > 0 && p < 1) {
+        const double meanRun = std::max({spec.mean_null_run, 1.0, p/(1-p)});
+        toValid = 1/meanRun;
+        toNull = p/((1-p)*meanRun);
+    }
+    int64_t nulls{0};
+    bool null = rng.unit() < p;
+    for(int64_t i=0; i<value_count; ++i) {
+        if(null) ++nulls;
+        else bitmap[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+        null = null ? rng.unit() >= toValid : rng.unit() < toNull;
+    }
+    *null_count = nulls;
+    return bitmap;
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Deltas the throughput tests sweep over (fitting within different bitwidths)
+ */
+constexpr std::array<int64_t, 11> benchmarkDeltas{{1, 10, 100, 500, 1000, 10000, 32000, 42000,
+                                                   1000000000, 3000000000, 4000000000000000000}};
+
+/**
+ * @brief splitmix64, used to derive independent seeds from one seed
+ */
+class SplitMix64 {
+public:
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t state;
+};
+
+/**
+ * @brief xoshiro256** generator: fast, 64 random bits per call and the same sequence on every platform
+ */
+class Xoshiro256 {
+public:
+    explicit Xoshiro256(uint64_t seed) {
+        SplitMix64 seeder(seed);
+        for(auto &word : state) word = seeder.next();
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(state[1]*5, 7)*9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief Uniformly distributed in [0, bound] without modulo bias (Lemire's multiply-shift)
+     */
+    uint64_t below_or_equal(uint64_t bound) {
+        if(bound == UINT64_MAX) return next();
+        const uint64_t range = bound+1;
+        unsigned __int128 product = static_cast<unsigned __int128>(next())*range;
+        uint64_t low = static_cast<uint64_t>(product);
+        if(low < range) {
+            const uint64_t threshold = (0-range) % range;
+            while(low < threshold) {
+                product = static_cast<unsigned __int128>(next())*range;
+                low = static_cast<uint64_t>(product);
+            }
+        }
+        return static_cast<uint64_t>(product >> 64);
+    }
+
+    /**
+     * @brief Uniformly distributed in [0, 1)
+     */
+    double unit() { return static_cast<double>(next() >> 11)*0x1.0p-53; }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64-k)); }
+
+    std::array<uint64_t, 4> state;
+};
+
+/**
+ * @brief Shape of the generated sequences. Apart from OutlierSpikes every kind is a running sum of
+ *        deltas drawn from a distribution scaled by WorkloadSpec::delta
+ */
+enum class Workload {
+    ConstantDelta, ///< every delta is delta
+    UniformDelta,  ///< deltas uniform in [0, delta]
+    ZipfDelta,     ///< deltas in [1, delta], Zipf distributed with zipf_exponent, most deltas are small
+    GaussianDelta, ///< deltas normal distributed with mean 0 and standard deviation delta (random walk)
+    Timestamps,    ///< sorted timestamps starting at timestamp_start, delta apart with uniform jitter
+    MonotonicIds,  ///< consecutive ids, with probability gap_probability a gap uniform in [2, delta]
+    OutlierSpikes, ///< constant delta with every spike_interval-th value offset by spike_magnitude
+    MixedBitwidth  ///< per DELTA_BINARY_PACKED miniblock a random bit width up to that of delta, deltas uniform within it
+};
+
+/**
+ * @brief Every Workload kind, the drivers sweep over them unless workloads are given
+ */
+constexpr std::array<Workload, 8> allWorkloads{{Workload::ConstantDelta, Workload::UniformDelta, Workload::ZipfDelta,
+                                                Workload::GaussianDelta, Workload::Timestamps, Workload::MonotonicIds,
+                                                Workload::OutlierSpikes, Workload::MixedBitwidth}};
+
+/**
+ * @brief Parameters of a generated sequence
+ */
+struct WorkloadSpec {
+    Workload kind{Workload::ConstantDelta};
+    //scale of the deltas, see Workload
+    int64_t delta{1};
+    //the same seed gives the same sequence regardless of the thread count
+    uint64_t seed{12141802};
+    //ZipfDelta: exponent s of P(k) ~ 1/k^s
+    double zipf_exponent{1.1};
+    //Timestamps: first value (ns since epoch) and maximum deviation from the nominal interval,
+    //a jitter of 0 uses delta/10
+    int64_t timestamp_start{1'600'000'000'000'000'000};
+    int64_t jitter{0};
+    //MonotonicIds: probability of a gap after an id
+    double gap_probability{0.01};
+    //OutlierSpikes: distance and offset of the spikes
+    int64_t spike_interval{1000};
+    int64_t spike_magnitude{int64_t{1} << 40};
+    //number of generating threads, 0 uses all hardware threads
+    int threads{0};
+};
+
+/**
+ * @brief Parses "constant", "uniform", "zipf", "gaussian", "timestamps", "ids", "spikes" or "mixed"
+ *
+ * @throw std::invalid_argument for any other name
+ */
+Workload parse_workload(const std::string &name);
+
+/**
+ * @brief Short name of the workload as accepted by parse_workload
+ */
+const char *workload_name(Workload workload);
+
+/**
+ * @brief Generates value_count values in parallel. The values are produced in fixed chunks, each with
+ *        its own generator seeded from spec.seed and the chunk index, and the running sums are stitched
+ *        together with a prefix sum over the chunks. Sums that leave the range of T are reflected at
+ *        its limits, so the sequence turns around instead of overflowing
+ *
+ * @tparam T int32_t or int64_t
+ * @param spec The workload and its parameters
+ * @param value_count The number of values to generate
+ * @return std::vector<T> the generated values
+ */
+template<typename T>
+std::vector<T> generate_workload(const WorkloadSpec &spec, int64_t value_count);
+
+extern template std::vector<int32_t> generate_workload<int32_t>(const WorkloadSpec &, int64_t);
+extern template std::vector<int64_t> generate_workload<int64_t>(const WorkloadSpec &, int64_t);
+
+/**
+ * @brief Where the null slots of a nullable column are
+ */
+struct NullSpec {
+    //fraction of the slots that are null
+    double null_fraction{0.1};
+    //mean length of a run of consecutive nulls, 0 places every null independently
+    double mean_null_run{0};
+    uint64_t seed{12141802};
+};
+
+/**
+ * @brief Generates a validity bitmap in Arrow's bit order (bit i%8 of byte i/8, set for valid slots).
+ *        Clustered nulls come from a two-state Markov chain whose null runs have mean_null_run as mean
+ *        length and whose valid runs are as long as needed to keep the null fraction; runs shorter than
+ *        the fraction allows are lengthened
+ *
+ * @param spec The null fraction and clustering
+ * @param value_count The number of slots
+ * @param null_count Receives the number of null slots
+ * @return std::vector<uint8_t> (value_count+7)/8 bytes, the unused bits of the last byte are 0
+ */
+std::vector<uint8_t> generate_validity(const NullSpec &spec, int64_t value_count, int64_t *null_count);